@@ -65,6 +65,7 @@ App::GetTypeId (void)
     
 App::App ()
   : m_protocolHandler (0)
+  , m_interestBatchHandler (0)
   , m_active (false)
   , m_face (0)
 {
@@ -90,6 +91,27 @@ App::RegisterProtocolHandler (ProtocolHandler handler)
 {
   m_protocolHandler = handler;
 }
+
+void
+App::RegisterInterestBatchHandler (InterestBatchHandler handler)
+{
+  m_interestBatchHandler = handler;
+}
+
+bool
+App::SendInterests (const InterestBatch &batch)
+{
+  NS_LOG_FUNCTION (this << batch.size ());
+
+  // strategies get the headers as is and may change them (e.g., locator, NACK type),
+  // so the trace has to see them before the batch is handed over
+  for (InterestBatch::const_iterator i = batch.begin (); i != batch.end (); i++)
+    {
+      m_transmittedInterests (i->first, this, m_face);
+    }
+
+  return m_interestBatchHandler (batch);
+}
     
 void
 App::OnInterest (const Ptr<const InterestHeader> &interest, Ptr<Packet> packet)
@@ -25,6 +25,7 @@
 #include "ns3/ptr.h"
 #include "ns3/callback.h"
 #include "ns3/traced-callback.h"
+#include "ns3/ndn-face.h"
 
 namespace ns3 {
 
@@ -49,6 +50,11 @@ public:
    * @brief A callback to pass packets to underlying NDN protocol
    */
   typedef Callback<bool, const Ptr<const Packet>&> ProtocolHandler;
+
+  /**
+   * @brief A callback to pass a batch of already decoded Interests to underlying NDN protocol
+   */
+  typedef Callback<bool, const InterestBatch&> InterestBatchHandler;
   
   static TypeId GetTypeId ();
 
@@ -63,6 +69,12 @@ public:
    */
   void
   RegisterProtocolHandler (ProtocolHandler handler);
+
+  /**
+   * @brief Register lower layer callback (to send batches of interests from the application)
+   */
+  void
+  RegisterInterestBatchHandler (InterestBatchHandler handler);
   
   /**
    * @brief Method that will be called every time new Interest arrives
@@ -103,8 +115,19 @@ protected:
   virtual void
   StopApplication ();     ///< @brief Called at time specified by Stop
 
+  /**
+   * @brief Send a batch of Interests to the NDN stack in one call
+   *
+   * Each element should contain the Interest header and the packet to which this header has been added.
+   * The stack uses headers as is (no copying and decoding), so they should not be modified afterwards.
+   * TransmittedInterests trace is fired for every Interest of the batch before the batch is passed to the stack
+   */
+  bool
+  SendInterests (const InterestBatch &batch);
+
 protected:
   ProtocolHandler m_protocolHandler; ///< @brief A callback to pass packets to underlying NDN protocol
+  InterestBatchHandler m_interestBatchHandler; ///< @brief A callback to pass batches of Interests to underlying NDN protocol
   bool m_active;  ///< @brief Flag to indicate that application is active (set by StartApplication and StopApplication)
   Ptr<Face> m_face;   ///< @brief automatically created application face through which application communicates
 
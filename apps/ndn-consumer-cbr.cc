@@ -56,6 +56,12 @@ ConsumerCbr::GetTypeId (void)
                    StringValue ("none"),
                    MakeStringAccessor (&ConsumerCbr::SetRandomize, &ConsumerCbr::GetRandomize),
                    MakeStringChecker ())
+
+    .AddAttribute ("MaxSeq",
+                   "Maximum sequence number to request",
+                   UintegerValue (std::numeric_limits<uint32_t>::max ()),
+                   MakeUintegerAccessor (&ConsumerCbr::m_seqMax),
+                   MakeUintegerChecker<uint32_t> ())
     ;
 
   return tid;
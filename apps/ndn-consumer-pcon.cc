@@ -0,0 +1,293 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-consumer-pcon.h"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/callback.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+
+#include "ns3/ndn-interest-header.h"
+
+#include <boost/lexical_cast.hpp>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerPcon");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ConsumerPcon);
+
+TypeId
+ConsumerPcon::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ConsumerPcon")
+    .SetGroupName ("Ndn")
+    .SetParent<Consumer> ()
+    .AddConstructor<ConsumerPcon> ()
+
+    .AddAttribute ("Window", "Initial size of the congestion window",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&ConsumerPcon::GetWindow, &ConsumerPcon::SetWindow),
+                   MakeDoubleChecker<double> (1.0))
+    .AddAttribute ("MinWindow", "Window is never decreased below this value",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&ConsumerPcon::m_minWindow),
+                   MakeDoubleChecker<double> (1.0))
+    .AddAttribute ("CcAlgorithm", "Window adaptation algorithm",
+                   EnumValue (ConsumerPcon::AIMD),
+                   MakeEnumAccessor (&ConsumerPcon::m_ccAlgorithm),
+                   MakeEnumChecker (ConsumerPcon::AIMD, "AIMD",
+                                    ConsumerPcon::CUBIC, "CUBIC"))
+    .AddAttribute ("SlowStart", "Enable slow start phase (window doubles every RTT until InitialSsthresh)",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&ConsumerPcon::m_slowStart),
+                   MakeBooleanChecker ())
+    .AddAttribute ("InitialSsthresh", "Initial slow start threshold",
+                   DoubleValue (std::numeric_limits<double>::max ()),
+                   MakeDoubleAccessor (&ConsumerPcon::m_ssthresh),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Beta", "Multiplicative decrease factor for AIMD",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&ConsumerPcon::m_beta),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("CubicBeta", "Multiplicative decrease factor for CUBIC",
+                   DoubleValue (0.7),
+                   MakeDoubleAccessor (&ConsumerPcon::m_cubicBeta),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("CubicC", "Scaling constant of CUBIC window growth function",
+                   DoubleValue (0.4),
+                   MakeDoubleAccessor (&ConsumerPcon::m_cubicC),
+                   MakeDoubleChecker<double> (0.0))
+
+    .AddAttribute ("PayloadSize", "Average size of content object size (to calculate interest generation rate)",
+                   UintegerValue (1040),
+                   MakeUintegerAccessor (&ConsumerPcon::GetPayloadSize, &ConsumerPcon::SetPayloadSize),
+                   MakeUintegerChecker<uint32_t>())
+    .AddAttribute ("Size", "Amount of data in megabytes to request (relies on PayloadSize parameter)",
+                   DoubleValue (-1), // don't impose limit by default
+                   MakeDoubleAccessor (&ConsumerPcon::GetMaxSize, &ConsumerPcon::SetMaxSize),
+                   MakeDoubleChecker<double> ())
+
+    .AddTraceSource ("WindowTrace",
+                     "Congestion window that controls how many outstanding interests are allowed",
+                     MakeTraceSourceAccessor (&ConsumerPcon::m_window))
+    .AddTraceSource ("InFlight",
+                     "Current number of outstanding interests",
+                     MakeTraceSourceAccessor (&ConsumerPcon::m_inFlight))
+    ;
+
+  return tid;
+}
+
+ConsumerPcon::ConsumerPcon ()
+  : m_payloadSize (1040)
+  , m_maxSize (-1)
+  , m_ccAlgorithm (AIMD)
+  , m_slowStart (true)
+  , m_ssthresh (std::numeric_limits<double>::max ())
+  , m_beta (0.5)
+  , m_cubicBeta (0.7)
+  , m_cubicC (0.4)
+  , m_minWindow (1.0)
+  , m_recoveryPoint (0)
+  , m_cubicWmax (0)
+  , m_window (1.0)
+  , m_inFlight (0)
+{
+}
+
+void
+ConsumerPcon::SetWindow (double window)
+{
+  m_window = window;
+}
+
+double
+ConsumerPcon::GetWindow () const
+{
+  return m_window;
+}
+
+uint32_t
+ConsumerPcon::GetPayloadSize () const
+{
+  return m_payloadSize;
+}
+
+void
+ConsumerPcon::SetPayloadSize (uint32_t payload)
+{
+  m_payloadSize = payload;
+}
+
+double
+ConsumerPcon::GetMaxSize () const
+{
+  if (m_seqMax == std::numeric_limits<uint32_t>::max ())
+    return -1.0;
+
+  return m_maxSize;
+}
+
+void
+ConsumerPcon::SetMaxSize (double size)
+{
+  m_maxSize = size;
+  if (m_maxSize < 0)
+    {
+      m_seqMax = std::numeric_limits<uint32_t>::max (); // no limit
+      return;
+    }
+
+  m_seqMax = floor(1.0 + m_maxSize * 1024.0 * 1024.0 / m_payloadSize);
+  NS_LOG_DEBUG ("MaxSeqNo: " << m_seqMax);
+}
+
+void
+ConsumerPcon::ScheduleNextPacket ()
+{
+  // NACKed and timed out Interests are removed from m_seqTimeouts, so its size is exactly
+  // the number of Interests currently in flight
+  m_inFlight = m_seqTimeouts.size ();
+
+  if (m_inFlight >= static_cast<uint32_t> (m_window))
+    return; // will be called again when Data, NACK, or timeout happens
+
+  if (!m_sendEvent.IsRunning ())
+    m_sendEvent = Simulator::ScheduleNow (&Consumer::SendPacket, this);
+}
+
+void
+ConsumerPcon::WindowIncrease ()
+{
+  if (m_slowStart && m_window < m_ssthresh)
+    {
+      m_window = m_window + 1.0;
+    }
+  else if (m_ccAlgorithm == CUBIC)
+    {
+      CubicIncrease ();
+    }
+  else
+    {
+      m_window = m_window + 1.0 / m_window;
+    }
+
+  NS_LOG_DEBUG ("Window: " << m_window << ", ssthresh: " << m_ssthresh);
+}
+
+void
+ConsumerPcon::CubicIncrease ()
+{
+  if (m_cubicWmax <= 0)
+    {
+      // congestion avoidance without any prior decrease: start new epoch at the current window
+      m_cubicWmax = m_window;
+      m_cubicLastDecrease = Simulator::Now ();
+    }
+
+  double t = (Simulator::Now () - m_cubicLastDecrease).ToDouble (Time::S);
+  double k = pow (m_cubicWmax * (1 - m_cubicBeta) / m_cubicC, 1.0 / 3);
+  double target = m_cubicC * pow (t - k, 3) + m_cubicWmax;
+
+  // TCP-friendly region: window should grow at least as fast as AIMD would
+  double rtt = m_rtt->GetCurrentEstimate ().ToDouble (Time::S);
+  if (rtt > 0)
+    {
+      double aimdWindow = m_cubicWmax * m_cubicBeta +
+        3 * (1 - m_cubicBeta) / (1 + m_cubicBeta) * t / rtt;
+      target = std::max (target, aimdWindow);
+    }
+
+  target = std::min (target, 1.5 * m_window);
+
+  if (target > m_window)
+    m_window = m_window + (target - m_window) / m_window;
+  else
+    m_window = m_window + 0.01 / m_window;
+}
+
+void
+ConsumerPcon::WindowDecrease (uint32_t seq)
+{
+  if (seq < m_recoveryPoint)
+    {
+      NS_LOG_DEBUG ("Window was already decreased for " << seq);
+      return;
+    }
+
+  double beta = (m_ccAlgorithm == CUBIC) ? m_cubicBeta : m_beta;
+
+  m_cubicWmax = m_window;
+  m_cubicLastDecrease = Simulator::Now ();
+
+  m_ssthresh = std::max (m_minWindow, m_window * beta);
+  m_window = m_ssthresh;
+  m_recoveryPoint = m_seq; // Interests that are already in flight should not cause another decrease
+
+  NS_LOG_DEBUG ("Decrease window to " << m_window << " (seq " << seq << ")");
+}
+
+///////////////////////////////////////////////////
+//          Process incoming packets             //
+///////////////////////////////////////////////////
+
+void
+ConsumerPcon::OnContentObject (const Ptr<const ContentObjectHeader> &contentObject,
+                               Ptr<Packet> payload)
+{
+  if (!m_active) return;
+
+  Consumer::OnContentObject (contentObject, payload);
+
+  WindowIncrease ();
+  ScheduleNextPacket ();
+}
+
+void
+ConsumerPcon::OnNack (const Ptr<const InterestHeader> &interest, Ptr<Packet> payload)
+{
+  if (!m_active) return;
+
+  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetComponents ().back ());
+
+  // Interest is no longer in flight. It will get a new timeout entry when retransmitted
+  m_seqTimeouts.erase (seq);
+  WindowDecrease (seq);
+
+  Consumer::OnNack (interest, payload);
+}
+
+void
+ConsumerPcon::OnTimeout (uint32_t sequenceNumber)
+{
+  WindowDecrease (sequenceNumber);
+  Consumer::OnTimeout (sequenceNumber);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_CONSUMER_PCON_H
+#define NDN_CONSUMER_PCON_H
+
+#include "ndn-consumer.h"
+#include "ns3/traced-value.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * \brief Ndn application for sending out Interest packets with congestion-controlled pipeline
+ *
+ * Number of outstanding Interests is limited by congestion window, which is adapted using
+ * either AIMD or CUBIC rules.  Window grows on every received Data (exponentially during
+ * the optional slow start phase) and is multiplicatively decreased on Interest timeout or NACK,
+ * at most once per window of Interests (i.e., once per RTT).
+ */
+class ConsumerPcon: public Consumer
+{
+public:
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Window adaptation algorithm
+   */
+  enum CcAlgorithm
+    {
+      AIMD,
+      CUBIC
+    };
+
+  /**
+   * \brief Default constructor
+   */
+  ConsumerPcon ();
+
+  // From App
+  virtual void
+  OnNack (const Ptr<const InterestHeader> &interest, Ptr<Packet> payload);
+
+  virtual void
+  OnContentObject (const Ptr<const ContentObjectHeader> &contentObject,
+                   Ptr<Packet> payload);
+
+  virtual void
+  OnTimeout (uint32_t sequenceNumber);
+
+protected:
+  /**
+   * \brief Constructs the Interest packet and sends it using a callback to the underlying NDN protocol
+   */
+  virtual void
+  ScheduleNextPacket ();
+
+private:
+  /**
+   * \brief Increase window after a Data packet is received
+   */
+  void
+  WindowIncrease ();
+
+  /**
+   * \brief Multiplicatively decrease window (if no decrease happened for Interests sent after seq)
+   */
+  void
+  WindowDecrease (uint32_t seq);
+
+  /**
+   * \brief Calculate CUBIC window increase (Ha et al., "CUBIC: a new TCP-friendly high-speed TCP variant")
+   */
+  void
+  CubicIncrease ();
+
+  void
+  SetWindow (double window);
+
+  double
+  GetWindow () const;
+
+  void
+  SetPayloadSize (uint32_t payload);
+
+  uint32_t
+  GetPayloadSize () const;
+
+  double
+  GetMaxSize () const;
+
+  void
+  SetMaxSize (double size);
+
+private:
+  uint32_t m_payloadSize; // expected payload size
+  double   m_maxSize; // max size to request
+
+  CcAlgorithm m_ccAlgorithm;
+  bool     m_slowStart;    ///< \brief Whether slow start phase is enabled
+  double   m_ssthresh;     ///< \brief Slow start threshold
+  double   m_beta;         ///< \brief Multiplicative decrease factor for AIMD
+  double   m_cubicBeta;    ///< \brief Multiplicative decrease factor for CUBIC
+  double   m_cubicC;       ///< \brief Scaling constant of CUBIC function
+  double   m_minWindow;
+
+  uint32_t m_recoveryPoint; ///< \brief Window is not decreased again for Interests sent before this sequence number
+  double   m_cubicWmax;     ///< \brief Window size before the last decrease
+  Time     m_cubicLastDecrease; ///< \brief Time of the last window decrease
+
+  TracedValue<double>   m_window;
+  TracedValue<uint32_t> m_inFlight;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_PCON_H
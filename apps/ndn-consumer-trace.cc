@@ -0,0 +1,170 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-consumer-trace.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include "ns3/ndn-interest-header.h"
+#include "ns3/ndn-name-components.h"
+
+#include "../utils/request-trace-file.h"
+
+#include <limits>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerTrace");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ConsumerTrace);
+
+TypeId
+ConsumerTrace::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ConsumerTrace")
+    .SetGroupName ("Ndn")
+    .SetParent<App> ()
+    .AddConstructor<ConsumerTrace> ()
+
+    .AddAttribute ("TraceFile", "Binary request trace (see tools/ndn-request-trace-convert)",
+                   StringValue (""),
+                   MakeStringAccessor (&ConsumerTrace::m_traceFile),
+                   MakeStringChecker ())
+    .AddAttribute ("FirstRecord", "Index of the first record to replay",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ConsumerTrace::m_firstRecord),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("RecordCount", "Number of records to replay (0 for all records till the end of the trace)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ConsumerTrace::m_recordCount),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("TimeShift", "Offset between trace time and simulation time",
+                   StringValue ("0s"),
+                   MakeTimeAccessor (&ConsumerTrace::m_timeShift),
+                   MakeTimeChecker ())
+    .AddAttribute ("LifeTime", "LifeTime for interest packet",
+                   StringValue ("2s"),
+                   MakeTimeAccessor (&ConsumerTrace::m_interestLifeTime),
+                   MakeTimeChecker ())
+    ;
+
+  return tid;
+}
+
+ConsumerTrace::ConsumerTrace ()
+  : m_firstRecord (0)
+  , m_recordCount (0)
+  , m_next (0)
+  , m_end (0)
+  , m_rand (0, std::numeric_limits<uint32_t>::max ())
+{
+}
+
+ConsumerTrace::~ConsumerTrace ()
+{
+}
+
+void
+ConsumerTrace::DoDispose ()
+{
+  m_trace = 0;
+  App::DoDispose ();
+}
+
+void
+ConsumerTrace::StartApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  App::StartApplication ();
+
+  if (m_trace == 0 || m_trace->GetFile () != m_traceFile)
+    m_trace = RequestTraceFile::Open (m_traceFile);
+
+  uint64_t total = m_trace->GetRecordCount ();
+  uint64_t first = std::min (m_firstRecord, total);
+  m_end = (m_recordCount == 0 || m_recordCount > total - first) ? total : first + m_recordCount;
+
+  // skip records that are already in the past
+  int64_t now = (Simulator::Now () - m_timeShift).GetNanoSeconds ();
+  m_next = (now > 0) ? m_trace->LowerBound (now, first, m_end) : first;
+
+  NS_LOG_DEBUG ("Replay records [" << m_next << ", " << m_end << ") of " << m_traceFile);
+  ScheduleNext ();
+}
+
+void
+ConsumerTrace::StopApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Simulator::Cancel (m_sendEvent);
+
+  App::StopApplication ();
+}
+
+void
+ConsumerTrace::ScheduleNext ()
+{
+  if (m_next >= m_end)
+    return; // done
+
+  Time at = NanoSeconds (m_trace->GetRecord (m_next).time) + m_timeShift;
+  m_sendEvent = Simulator::Schedule (at - Simulator::Now (), &ConsumerTrace::SendDueInterests, this);
+}
+
+void
+ConsumerTrace::SendDueInterests ()
+{
+  if (!m_active) return;
+
+  // all due records are passed to the stack as one batch
+  InterestBatch batch;
+
+  int64_t now = (Simulator::Now () - m_timeShift).GetNanoSeconds ();
+  for (; m_next < m_end && static_cast<int64_t> (m_trace->GetRecord (m_next).time) <= now; m_next++)
+    {
+      const RequestTraceFile::Record &record = m_trace->GetRecord (m_next);
+
+      Ptr<NameComponents> name = Create<NameComponents> (m_trace->GetName (record.name));
+      if (record.seq != RequestTraceFormat::NO_SEQ)
+        (*name) (record.seq);
+
+      Ptr<InterestHeader> interestHeader = Create<InterestHeader> ();
+      interestHeader->SetNonce            (m_rand.GetValue ());
+      interestHeader->SetName             (name);
+      interestHeader->SetInterestLifetime (m_interestLifeTime);
+
+      NS_LOG_INFO ("> Interest for " << *name);
+
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (*interestHeader);
+
+      batch.push_back (std::make_pair (interestHeader, packet));
+    }
+
+  SendInterests (batch);
+
+  ScheduleNext ();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,96 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_CONSUMER_TRACE_H
+#define NDN_CONSUMER_TRACE_H
+
+#include "ndn-app.h"
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/random-variable.h"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+class RequestTraceFile;
+
+/**
+ * @ingroup ndn
+ * \brief Ndn application replaying Interests from a binary request trace (see RequestTraceFormat)
+ *
+ * The trace file is memory-mapped and shared between all consumers replaying the same file.
+ * Each consumer replays records [FirstRecord, FirstRecord + RecordCount) and keeps only one
+ * pending event, so memory usage does not depend on the trace length.
+ *
+ * Record with time t is replayed at simulation time t + TimeShift.  Records that should have
+ * been replayed before the application is started are skipped.  Interests are not retransmitted.
+ * Interests for records with the same time are passed to the stack as one batch (see App::SendInterests).
+ */
+class ConsumerTrace: public App
+{
+public:
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Default constructor
+   */
+  ConsumerTrace ();
+  virtual ~ConsumerTrace ();
+
+protected:
+  // from App
+  virtual void
+  StartApplication ();
+
+  virtual void
+  StopApplication ();
+
+  virtual void
+  DoDispose ();
+
+private:
+  /**
+   * \brief Send Interests for all due records and schedule event for the next one
+   */
+  void
+  SendDueInterests ();
+
+  void
+  ScheduleNext ();
+
+private:
+  std::string m_traceFile;
+  uint64_t m_firstRecord;
+  uint64_t m_recordCount; ///< @brief 0 means till the end of the trace
+  Time     m_timeShift;
+  Time     m_interestLifeTime;
+
+  Ptr<RequestTraceFile> m_trace;
+  uint64_t m_next; ///< @brief index of the next record to replay
+  uint64_t m_end;  ///< @brief index past the last record to replay
+  EventId  m_sendEvent;
+  UniformVariable m_rand; ///< @brief nonce generator
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_TRACE_H
@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-consumer-zipf-mandelbrot.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+#include "../utils/alias-sampler.h"
+
+#include <boost/weak_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerZipfMandelbrot");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ConsumerZipfMandelbrot);
+
+TypeId
+ConsumerZipfMandelbrot::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::ConsumerZipfMandelbrot")
+    .SetGroupName ("Ndn")
+    .SetParent<ConsumerCbr> ()
+    .AddConstructor<ConsumerZipfMandelbrot> ()
+
+    .AddAttribute ("NumberOfContents", "Number of different contents (sequence numbers) that can be requested",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&ConsumerZipfMandelbrot::GetNumberOfContents,
+                                         &ConsumerZipfMandelbrot::SetNumberOfContents),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("q", "Parameter q of Zipf-Mandelbrot distribution (plateau)",
+                   DoubleValue (0.7),
+                   MakeDoubleAccessor (&ConsumerZipfMandelbrot::GetQ, &ConsumerZipfMandelbrot::SetQ),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("s", "Parameter s of Zipf-Mandelbrot distribution (skewness)",
+                   DoubleValue (0.7),
+                   MakeDoubleAccessor (&ConsumerZipfMandelbrot::GetS, &ConsumerZipfMandelbrot::SetS),
+                   MakeDoubleChecker<double> (0.0))
+    ;
+
+  return tid;
+}
+
+ConsumerZipfMandelbrot::ConsumerZipfMandelbrot ()
+  : m_numOfContents (100)
+  , m_q (0.7)
+  , m_s (0.7)
+  , m_seqRng (0.0, 1.0)
+{
+}
+
+ConsumerZipfMandelbrot::~ConsumerZipfMandelbrot ()
+{
+}
+
+void
+ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
+{
+  m_numOfContents = numOfContents;
+  m_sampler.reset ();
+}
+
+uint32_t
+ConsumerZipfMandelbrot::GetNumberOfContents () const
+{
+  return m_numOfContents;
+}
+
+void
+ConsumerZipfMandelbrot::SetQ (double q)
+{
+  m_q = q;
+  m_sampler.reset ();
+}
+
+double
+ConsumerZipfMandelbrot::GetQ () const
+{
+  return m_q;
+}
+
+void
+ConsumerZipfMandelbrot::SetS (double s)
+{
+  m_s = s;
+  m_sampler.reset ();
+}
+
+double
+ConsumerZipfMandelbrot::GetS () const
+{
+  return m_s;
+}
+
+boost::shared_ptr<const AliasSampler>
+ConsumerZipfMandelbrot::GetSampler (uint32_t numOfContents, double q, double s)
+{
+  typedef std::pair<uint32_t, std::pair<double, double> > Key;
+  // tables are released when the last consumer that uses them is destroyed
+  static std::map<Key, boost::weak_ptr<const AliasSampler> > samplers;
+
+  // drop tables of consumers that are already gone
+  for (std::map<Key, boost::weak_ptr<const AliasSampler> >::iterator i = samplers.begin ();
+       i != samplers.end (); )
+    {
+      if (i->second.expired ())
+        samplers.erase (i++);
+      else
+        i++;
+    }
+
+  Key key (numOfContents, std::make_pair (q, s));
+  boost::shared_ptr<const AliasSampler> sampler = samplers[key].lock ();
+  if (!sampler)
+    {
+      NS_LOG_DEBUG ("Build alias table for N=" << numOfContents << ", q=" << q << ", s=" << s);
+      sampler = boost::make_shared<AliasSampler> (AliasSampler::ZipfMandelbrot (numOfContents, q, s));
+      samplers[key] = sampler;
+    }
+  return sampler;
+}
+
+uint32_t
+ConsumerZipfMandelbrot::GetNextSeq ()
+{
+  if (!m_sampler)
+    m_sampler = GetSampler (m_numOfContents, m_q, m_s);
+
+  m_seq++; // counts expressed Interests, so MaxSeq limits their number
+  uint32_t seq = m_sampler->Sample (m_seqRng.GetValue ());
+  NS_LOG_DEBUG ("Next seq: " << seq);
+  return seq;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_CONSUMER_ZIPF_MANDELBROT_H
+#define NDN_CONSUMER_ZIPF_MANDELBROT_H
+
+#include "ndn-consumer-cbr.h"
+#include "ns3/random-variable.h"
+
+#include <boost/shared_ptr.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+class AliasSampler;
+
+/**
+ * @ingroup ndn
+ * \brief Ndn application for sending out Interest packets at a "constant" rate for contents
+ * with Zipf-Mandelbrot popularity
+ *
+ * Sequence number of each new Interest is in range [0, NumberOfContents) and is selected with
+ * probability p(k) ~ 1/(k+q)^s, where k = seq+1 is the content rank.  Sampling takes O(1) time
+ * using a precomputed alias table, which is shared among all consumers with the same
+ * NumberOfContents, q, and s
+ */
+class ConsumerZipfMandelbrot: public ConsumerCbr
+{
+public:
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Default constructor
+   */
+  ConsumerZipfMandelbrot ();
+  virtual ~ConsumerZipfMandelbrot ();
+
+protected:
+  virtual uint32_t
+  GetNextSeq ();
+
+private:
+  void
+  SetNumberOfContents (uint32_t numOfContents);
+
+  uint32_t
+  GetNumberOfContents () const;
+
+  void
+  SetQ (double q);
+
+  double
+  GetQ () const;
+
+  void
+  SetS (double s);
+
+  double
+  GetS () const;
+
+  /**
+   * \brief Get alias table for the current parameters (shared with other consumers, if possible)
+   */
+  static boost::shared_ptr<const AliasSampler>
+  GetSampler (uint32_t numOfContents, double q, double s);
+
+private:
+  uint32_t m_numOfContents;
+  double   m_q;
+  double   m_s;
+
+  boost::shared_ptr<const AliasSampler> m_sampler; ///< @brief created on first use
+  UniformVariable m_seqRng;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_ZIPF_MANDELBROT_H
@@ -97,7 +97,7 @@ Consumer::GetTypeId (void)
                    MakeNameComponentsAccessor (&Consumer::m_exclude),
                    MakeNameComponentsChecker ())
     .AddAttribute ("RetxTimer",
-                   "Timeout defining how frequent retransmission timeouts should be checked",
+                   "Obsolete. Retransmission timeouts are checked at the earliest expiration time of outstanding Interests",
                    StringValue ("50ms"),
                    MakeTimeAccessor (&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                    MakeTimeChecker ())
@@ -117,21 +117,13 @@ Consumer::Consumer ()
   NS_LOG_FUNCTION_NOARGS ();
 
   m_rtt = CreateObject<RttMeanDeviation> ();
+  m_retxCheck.SetFunction (MakeCallback (&Consumer::CheckRetxTimeout, this));
 }
 
 void
 Consumer::SetRetxTimer (Time retxTimer)
 {
   m_retxTimer = retxTimer;
-  if (m_retxEvent.IsRunning ())
-    {
-      // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-      Simulator::Remove (m_retxEvent); // slower, but better for memory
-    }
-
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule (m_retxTimer,
-                                     &Consumer::CheckRetxTimeout, this); 
 }
 
 Time
@@ -140,6 +132,18 @@ Consumer::GetRetxTimer () const
   return m_retxTimer;
 }
 
+const LatencyHistogram &
+Consumer::GetRttHistogram () const
+{
+  return m_rttHistogram;
+}
+
+const LatencyHistogram &
+Consumer::GetDelayHistogram () const
+{
+  return m_delayHistogram;
+}
+
 void
 Consumer::CheckRetxTimeout ()
 {
@@ -161,8 +165,22 @@ Consumer::CheckRetxTimeout ()
         break; // nothing else to do. All later packets need not be retransmitted
     }
 
-  m_retxEvent = Simulator::Schedule (m_retxTimer,
-                                     &Consumer::CheckRetxTimeout, this); 
+  ScheduleRetxCheck ();
+}
+
+void
+Consumer::ScheduleRetxCheck ()
+{
+  if (m_seqTimeouts.empty ())
+    return; // idle. If event is still pending, it will fire once and will not re-arm
+
+  m_retxCheck.Arm (m_seqTimeouts.get<i_timestamp> ().begin ()->time + m_rtt->RetransmitTimeout ());
+}
+
+uint32_t
+Consumer::GetNextSeq ()
+{
+  return m_seq++;
 }
 
 // Application Methods
@@ -184,6 +202,7 @@ Consumer::StopApplication () // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel (m_sendEvent);
+  m_retxCheck.Cancel ();
 
   // cleanup base stuff
   App::StopApplication ();
@@ -226,7 +245,7 @@ Consumer::SendPacket ()
             }
         }
       
-      seq = m_seq++;
+      seq = GetNextSeq ();
     }
   
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
@@ -234,42 +253,44 @@ Consumer::SendPacket ()
   Ptr<NameComponents> nameWithSequence = Create<NameComponents> (m_interestName);
   (*nameWithSequence) (seq);
 
-  InterestHeader interestHeader;
-  interestHeader.SetNonce               (m_rand.GetValue ());
-  interestHeader.SetName                (nameWithSequence);
+  Ptr<InterestHeader> interestHeader = Create<InterestHeader> ();
+  interestHeader->SetNonce               (m_rand.GetValue ());
+  interestHeader->SetName                (nameWithSequence);
   
   if(m_locatorName.size()>0)
   {
-      interestHeader.SetLocator    (Create<NameComponents> (m_locatorName));
+      interestHeader->SetLocator    (Create<NameComponents> (m_locatorName));
   }
   
-  interestHeader.SetInterestLifetime    (m_interestLifeTime);
-  interestHeader.SetChildSelector       (m_childSelector);
+  interestHeader->SetInterestLifetime    (m_interestLifeTime);
+  interestHeader->SetChildSelector       (m_childSelector);
   if (m_exclude.size ()>0)
   {
-      interestHeader.SetExclude (Create<NameComponents> (m_exclude));
+      interestHeader->SetExclude (Create<NameComponents> (m_exclude));
   }
   
-  interestHeader.SetAgent(m_isfromAgent);
-  interestHeader.SetMaxSuffixComponents (m_maxSuffixComponents);
-  interestHeader.SetMinSuffixComponents (m_minSuffixComponents);
+  interestHeader->SetAgent(m_isfromAgent);
+  interestHeader->SetMaxSuffixComponents (m_maxSuffixComponents);
+  interestHeader->SetMinSuffixComponents (m_minSuffixComponents);
         
   // NS_LOG_INFO ("Requesting Interest: \n" << interestHeader);
   NS_LOG_INFO ("> Interest for " << seq);
 
   Ptr<Packet> packet = Create<Packet> ();
-  packet->AddHeader (interestHeader);
+  packet->AddHeader (*interestHeader);
   NS_LOG_DEBUG ("Interest packet size: " << packet->GetSize ());
 
-  m_protocolHandler (packet);
+  InterestBatch batch;
+  batch.push_back (std::make_pair (interestHeader, packet));
+  SendInterests (batch); // TransmittedInterests trace is fired inside
 
   NS_LOG_DEBUG ("Trying to add " << seq << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");  
   
   m_seqTimeouts.insert (SeqTimeout (seq, Simulator::Now ()));
   m_seqLifetimes.insert (SeqTimeout (seq, Simulator::Now () + m_interestLifeTime)); // only one insert will work. if entry exists, nothing will happen... nothing should happen
-  m_transmittedInterests (&interestHeader, this, m_face);
 
   m_rtt->SentSeq (SequenceNumber32 (seq), 1);
+  ScheduleRetxCheck ();
   ScheduleNextPacket ();
 }
 
@@ -306,11 +327,21 @@ Consumer::OnContentObject (const Ptr<const ContentObjectHeader> &contentObject,
   // if (entry != m_seqTimeouts.end ())
   //   m_seqTimeouts.erase (entry);
 
+  SeqTimeoutsContainer::iterator entry = m_seqTimeouts.find (seq);
+  if (entry != m_seqTimeouts.end ())
+    m_rttHistogram.Record (Simulator::Now () - entry->time);
+
+  // lifetime entry is created only on the first transmission
+  SeqTimeoutsContainer::iterator lifetime = m_seqLifetimes.find (seq);
+  if (lifetime != m_seqLifetimes.end ())
+    m_delayHistogram.Record (Simulator::Now () - (lifetime->time - m_interestLifeTime));
+
   m_seqLifetimes.erase (seq);
   m_seqTimeouts.erase (seq);
   m_retxSeqs.erase (seq);
 
   m_rtt->AckSeq (SequenceNumber32 (seq));
+  ScheduleRetxCheck (); // RTO could have decreased
 
   // Ptr<const WeightsPathStretchTag> tag = payload->RemovePacketTag<WeightsPathStretchTag> ();
   // if (tag != 0)
@@ -33,6 +33,8 @@
 #include "ns3/ndn-name-components.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
+#include "ns3/latency-histogram.h"
+#include "ns3/retx-timer.h"
 #include "../../internet/model/rtt-estimator.h"
 //#include "ns3/internet-module.h"
 
@@ -85,6 +87,19 @@ public:
    */
   void
   SendPacket ();
+
+  /**
+   * @brief Get histogram of RTTs, measured from the last transmission of the Interest
+   */
+  const LatencyHistogram &
+  GetRttHistogram () const;
+
+  /**
+   * @brief Get histogram of delays, measured from the first transmission of the Interest
+   *        (i.e., including all retransmissions)
+   */
+  const LatencyHistogram &
+  GetDelayHistogram () const;
   
 protected:
   // from App
@@ -99,23 +114,39 @@ protected:
    */
   virtual void
   ScheduleNextPacket () = 0;
+
+  /**
+   * \brief Returns sequence number for the next Interest that is not a retransmission
+   *
+   * Default implementation requests increasing sequence numbers starting from StartSeq
+   */
+  virtual uint32_t
+  GetNextSeq ();
   
   /**
    * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
    */
   void
   CheckRetxTimeout ();
+
+  /**
+   * \brief Makes sure that retransmission check is scheduled no later than the earliest deadline in m_seqTimeouts
+   *
+   * See RetxTimer.  Nothing is scheduled while there are no outstanding Interests.
+   */
+  void
+  ScheduleRetxCheck ();
   
   /**
-   * \brief Modifies the frequency of checking the retransmission timeouts
-   * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Sets value of RetxTimer attribute
+   *
+   * Retransmission checks are no longer polled; the value is only kept for compatibility
    */
   void
   SetRetxTimer (Time retxTimer);
 
   /**
-   * \brief Returns the frequency of checking the retransmission timeouts
-   * \return Timeout defining how frequent retransmission timeouts should be checked
+   * \brief Returns value of RetxTimer attribute
    */
   Time
   GetRetxTimer () const;
@@ -127,9 +158,11 @@ protected:
   uint32_t        m_seqMax;    ///< @brief maximum number of sequence number
   EventId         m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time            m_retxTimer; ///< @brief Currently estimated retransmission timer
-  EventId         m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  RetxTimer       m_retxCheck; ///< @brief Event to check whether or not retransmission should be performed
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
+  LatencyHistogram m_rttHistogram;   ///< @brief RTTs of satisfied Interests (from the last transmission)
+  LatencyHistogram m_delayHistogram; ///< @brief Delays of satisfied Interests (from the first transmission)
   
   Time               m_offTime;             ///< \brief Time interval between packets
   NameComponents     m_interestName;        ///< \brief NDN Name of the Interest (use NameComponents)
@@ -55,6 +55,10 @@
 #include "ns3/unused.h"
 #include "../helper/ndn-encoding-helper.h"
 #include "../helper/ndn-decoding-helper.h"
+#include "ns3/buffer.h"
+
+#include <cstring>
+#include <algorithm>
 
 namespace ll = boost::lambda;
 
@@ -88,6 +92,15 @@ ProducerAgent::GetTypeId (void)
                    BooleanValue(false),
                    MakeBooleanAccessor(&ProducerAgent::m_isopenCache),
                    MakeBooleanChecker())
+    .AddAttribute ("ReplayRate","Rate (Interests per second) of re-expression of Interests buffered during handoff. "
+                   "0 re-expresses all buffered Interests at once",
+                   DoubleValue (1000.0),
+                   MakeDoubleAccessor (&ProducerAgent::m_replayRate),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("ReplayBurst","Number of buffered Interests re-expressed at once during paced replay",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&ProducerAgent::m_replayBurst),
+                   MakeUintegerChecker<uint32_t> (1))
     ;
         
   return tid;
@@ -95,7 +108,11 @@ ProducerAgent::GetTypeId (void)
     
 ProducerAgent::ProducerAgent ()
 	:m_isfromAgent (1)
+	,m_iscached (false)
 	,m_forwardtime (0)
+	,m_replayRate (1000.0)
+	,m_replayBurst (8)
+	,m_nonceOffset (0)
 {
   // NS_LOG_FUNCTION_NOARGS ();
 }
@@ -118,6 +135,8 @@ ProducerAgent::StartApplication ()
   fibEntry->UpdateStatus (m_face, fib::FaceMetric::NDN_FIB_GREEN);
 
   SetForwardTime(Simulator::Now () + m_handoffTime);
+  // re-express buffered Interests as soon as forwarding resumes
+  m_forwardEvent = Simulator::Schedule (m_handoffTime, &ProducerAgent::StartReplay, this);
   
   // // make face green, so it will be used primarily
   // StaticCast<fib::FibImpl> (fib)->modify (fibEntry,
@@ -131,6 +150,9 @@ ProducerAgent::StopApplication ()
   NS_LOG_FUNCTION_NOARGS ();
   NS_ASSERT (GetNode ()->GetObject<Fib> () != 0);
 
+  Simulator::Cancel (m_forwardEvent);
+  Simulator::Cancel (m_replayEvent);
+
   App::StopApplication ();
 }
 
@@ -194,19 +216,7 @@ ProducerAgent::OnInterest (const Ptr<const InterestHeader> &interest, Ptr<Packet
 		  
 	if(IsCachedInterest())
 	{
-          BOOST_FOREACH(const uint32_t t_seq, intr_container)
-          {
-            Ptr<NameComponents> nameWithSequence = Create<NameComponents> (m_prefix);
-            (*nameWithSequence) (t_seq);
-            cachedHeader.SetName(nameWithSequence);
-            Ptr<Packet> packet = Create<Packet> ();
-            packet->AddHeader (cachedHeader);
-            NS_LOG_DEBUG ("Interest packet size: " << packet->GetSize ());
-
-            m_protocolHandler (packet);
-          }
-          intr_container.clear();
-          SetCacheInterest(false);
+          StartReplay ();
 	}
 
       cachedHeader.SetName (Create<NameComponents> (interest->GetName ()));
@@ -222,6 +232,8 @@ ProducerAgent::OnInterest (const Ptr<const InterestHeader> &interest, Ptr<Packet
       	{
         uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetComponents ().back ());
         intr_container.insert(seq);
+        if (m_replayHeader == 0)
+          m_replayHeader = interest;
         SetCacheInterest(true);
       	}
 	return;      
@@ -230,5 +242,130 @@ ProducerAgent::OnInterest (const Ptr<const InterestHeader> &interest, Ptr<Packet
 
 }
 
+void
+ProducerAgent::StartReplay ()
+{
+  if (!m_active || m_replayEvent.IsRunning () || intr_container.empty () || m_locatorName.size () == 0)
+    return;
+
+  NS_LOG_DEBUG ("Re-express " << intr_container.size () << " Interests buffered during handoff");
+
+  BuildReplayTemplate (*m_replayHeader);
+  ReplayNext ();
+}
+
+void
+ProducerAgent::ReplayNext ()
+{
+  uint32_t burst = (m_replayRate > 0) ? m_replayBurst : intr_container.size ();
+
+  uint32_t sent = 0;
+  for (; sent < burst && !intr_container.empty (); sent++)
+    {
+      uint32_t seq = *intr_container.begin ();
+      intr_container.erase (intr_container.begin ());
+
+      m_protocolHandler (CreateReplayPacket (seq));
+    }
+
+  if (intr_container.empty ())
+    {
+      SetCacheInterest (false);
+      m_replayHeader = 0;
+      return;
+    }
+
+  m_replayEvent = Simulator::Schedule (Seconds (sent / m_replayRate), &ProducerAgent::ReplayNext, this);
+}
+
+void
+ProducerAgent::BuildReplayTemplate (const InterestHeader &interest)
+{
+  InterestHeader header;
+  header.SetNonce              (1); // placeholder, nonce should be present in the encoding
+  header.SetName               (Create<NameComponents> (m_prefix));
+  header.SetLocator            (Create<NameComponents> (m_locatorName));
+  header.SetInterestLifetime   (interest.GetInterestLifetime ());
+  header.SetChildSelector      (interest.IsEnabledChildSelector ());
+  if (interest.IsEnabledExclude () && (interest.GetExclude ().size () > 0))
+    {
+      header.SetExclude (Create<NameComponents> (interest.GetExclude ()));
+    }
+  header.SetAgent              (m_isfromAgent);
+  header.SetMaxSuffixComponents (interest.GetMaxSuffixComponents ());
+  header.SetMinSuffixComponents (interest.GetMinSuffixComponents ());
+
+  uint32_t size = header.GetSerializedSize ();
+  Buffer buffer;
+  buffer.AddAtStart (size);
+  header.Serialize (buffer.Begin ());
+  std::vector<uint8_t> encoded (size);
+  buffer.CopyData (&encoded[0], size);
+
+  // <Interest><Name><Component>...</Component>... | sequence number component goes here | </Name>...</Interest>
+  size_t headSize =
+    EncodingHelper::EstimateBlockHeader (CcnbParser::CCN_DTAG_Interest) +
+    EncodingHelper::EstimateBlockHeader (CcnbParser::CCN_DTAG_Name) +
+    EncodingHelper::EstimateNameComponents (m_prefix);
+  m_templateHead.assign (encoded.begin (), encoded.begin () + headSize);
+  m_templateTail.assign (encoded.begin () + headSize, encoded.end ());
+
+  // template has no NACK, so nonce BLOB is the last element: ...<Nonce>4 bytes</Nonce></Interest>
+  m_nonceOffset = m_templateTail.size () - 2 - sizeof (uint32_t);
+  uint32_t placeholder = 1;
+  NS_ASSERT_MSG (std::memcmp (&m_templateTail[m_nonceOffset], &placeholder, sizeof (uint32_t)) == 0,
+                 "Unexpected encoding of Interest nonce");
+  NS_UNUSED (placeholder);
+
+  // encoded <Component> header (DTAG and BLOB length) for every possible number of digits in uint32_t
+  m_componentHeaders.resize (11);
+  for (uint32_t digits = 1; digits < m_componentHeaders.size (); digits++)
+    {
+      std::vector<uint8_t> data (digits, '0');
+      size_t componentSize = EncodingHelper::EstimateTaggedBlob (CcnbParser::CCN_DTAG_Component, digits);
+      Buffer componentBuffer;
+      componentBuffer.AddAtStart (componentSize);
+      Buffer::Iterator i = componentBuffer.Begin ();
+      EncodingHelper::AppendTaggedBlob (i, CcnbParser::CCN_DTAG_Component, &data[0], digits);
+
+      std::vector<uint8_t> component (componentSize);
+      componentBuffer.CopyData (&component[0], componentSize);
+      m_componentHeaders[digits].assign (component.begin (), component.end () - digits - 1); // without data and closer
+    }
+}
+
+Ptr<Packet>
+ProducerAgent::CreateReplayPacket (uint32_t seq)
+{
+  // decimal representation, as NameComponents::operator () would produce
+  char digits[10];
+  uint32_t length = 0;
+  do
+    {
+      digits[length++] = '0' + seq % 10;
+      seq /= 10;
+    }
+  while (seq > 0);
+  std::reverse (digits, digits + length);
+
+  const std::vector<uint8_t> &componentHeader = m_componentHeaders[length];
+
+  m_scratch.clear ();
+  m_scratch.insert (m_scratch.end (), m_templateHead.begin (), m_templateHead.end ());
+  m_scratch.insert (m_scratch.end (), componentHeader.begin (), componentHeader.end ());
+  m_scratch.insert (m_scratch.end (), digits, digits + length);
+  m_scratch.push_back (CcnbParser::CCN_CLOSE); // </Component>
+  size_t tailOffset = m_scratch.size ();
+  m_scratch.insert (m_scratch.end (), m_templateTail.begin (), m_templateTail.end ());
+
+  uint32_t nonce = m_rand.GetValue ();
+  if (nonce == 0)
+    nonce = 1; // zero nonce is not encoded
+  std::memcpy (&m_scratch[tailOffset + m_nonceOffset], &nonce, sizeof (uint32_t));
+
+  NS_LOG_DEBUG ("Re-express Interest for seq " << std::string (digits, length));
+  return Create<Packet> (&m_scratch[0], m_scratch.size ());
+}
+
 } // namespace ndn
 } // namespace ns3
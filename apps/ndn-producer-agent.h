@@ -39,11 +39,13 @@
 #include "ns3/ndn-content-object-header.h"
 
 #include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include "ns3/random-variable.h"
 #include "ns3/data-rate.h"
 #include "../../internet/model/rtt-estimator.h"
 
 #include <set>
+#include <vector>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -89,6 +91,12 @@ public:
   bool
   IsCachedInterest () const;
 
+  /**
+   * @brief Start paced re-expression of Interests buffered during handoff (if not already started)
+   */
+  void
+  StartReplay ();
+
 protected:
   // inherited from Application base class.
   virtual void
@@ -101,6 +109,25 @@ protected:
 
   seq_container intr_container;
 
+private:
+  /**
+   * @brief Send next portion of buffered Interests and schedule the following one
+   */
+  void
+  ReplayNext ();
+
+  /**
+   * @brief Encode template Interest (name is m_prefix, without sequence number) for the replay
+   */
+  void
+  BuildReplayTemplate (const InterestHeader &header);
+
+  /**
+   * @brief Create Interest packet from the template, with seq appended to the name and new nonce
+   */
+  Ptr<Packet>
+  CreateReplayPacket (uint32_t seq);
+
 private:
   NameComponents m_prefix;
   NameComponents m_locatorName;
@@ -109,6 +136,18 @@ private:
   bool m_iscached;
   Time m_handoffTime;
   Time m_forwardtime;
+
+  double   m_replayRate;  ///< @brief rate of re-expression of buffered Interests (Interests per second)
+  uint32_t m_replayBurst; ///< @brief number of Interests re-expressed at once
+  EventId  m_replayEvent;
+  EventId  m_forwardEvent;
+
+  Ptr<const InterestHeader> m_replayHeader; ///< @brief first buffered Interest, source of selectors for the replay
+  std::vector<uint8_t> m_templateHead; ///< @brief encoded template up to (not including) sequence number component
+  std::vector<uint8_t> m_templateTail; ///< @brief encoded template after the name components
+  size_t m_nonceOffset; ///< @brief offset of the nonce in m_templateTail
+  std::vector< std::vector<uint8_t> > m_componentHeaders; ///< @brief encoded component headers, by number of digits
+  std::vector<uint8_t> m_scratch;
   /*
   uint32_t m_virtualPayloadSize;
   
@@ -102,7 +102,14 @@ Producer::StartApplication ()
   Ptr<fib::Entry> fibEntry = fib->Add (m_prefix, m_face, 0);
 
   fibEntry->UpdateStatus (m_face, fib::FaceMetric::NDN_FIB_GREEN);
-  
+
+  if (m_locatorName.size () > 0)
+    {
+      // Interests carrying the locator (e.g., re-expressed by ProducerAgent) are matched against the locator
+      Ptr<fib::Entry> locatorEntry = fib->Add (m_locatorName, m_face, 0);
+      locatorEntry->UpdateStatus (m_face, fib::FaceMetric::NDN_FIB_GREEN);
+    }
+
   // // make face green, so it will be used primarily
   // StaticCast<fib::FibImpl> (fib)->modify (fibEntry,
   //                                        ll::bind (&fib::Entry::UpdateStatus,
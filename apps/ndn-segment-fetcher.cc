@@ -0,0 +1,385 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-segment-fetcher.h"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include "ns3/ndn-interest-header.h"
+#include "ns3/ndn-content-object-header.h"
+
+#include <boost/lexical_cast.hpp>
+#include <limits>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.SegmentFetcher");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (SegmentFetcher);
+
+TypeId
+SegmentFetcher::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::SegmentFetcher")
+    .SetGroupName ("Ndn")
+    .SetParent<App> ()
+    .AddConstructor<SegmentFetcher> ()
+
+    .AddAttribute ("Prefix", "Prefix of the objects. Segment s of object o has name Prefix/o/s",
+                   StringValue ("/"),
+                   MakeNameComponentsAccessor (&SegmentFetcher::m_prefix),
+                   MakeNameComponentsChecker ())
+    .AddAttribute ("NumberOfSegments", "Number of segments in each object",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&SegmentFetcher::m_segments),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("PipelineDepth", "Maximum number of Interests in flight",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&SegmentFetcher::m_pipelineDepth),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("StartObject", "Id of the first object to fetch",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&SegmentFetcher::m_startObject),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("ObjectCount", "Number of objects to fetch one after another (0 for unlimited)",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&SegmentFetcher::m_objectCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Interval", "Time between completion of one object and start of the next one",
+                   StringValue ("0s"),
+                   MakeTimeAccessor (&SegmentFetcher::m_interval),
+                   MakeTimeChecker ())
+    .AddAttribute ("LifeTime", "LifeTime for interest packet",
+                   StringValue ("2s"),
+                   MakeTimeAccessor (&SegmentFetcher::m_interestLifeTime),
+                   MakeTimeChecker ())
+
+    .AddTraceSource ("ObjectCompleted",
+                     "Object is completely fetched: object id, completion time, number of segments, "
+                     "number of retransmissions, maximum reordering (in segments)",
+                     MakeTraceSourceAccessor (&SegmentFetcher::m_objectCompleted))
+    ;
+
+  return tid;
+}
+
+SegmentFetcher::SegmentFetcher ()
+  : m_segments (100)
+  , m_pipelineDepth (16)
+  , m_startObject (0)
+  , m_objectCount (1)
+  , m_rand (0, std::numeric_limits<uint32_t>::max ())
+  , m_object (0)
+  , m_objectsFetched (0)
+  , m_inFlightCount (0)
+  , m_nextSegment (0)
+  , m_inOrder (0)
+  , m_receivedCount (0)
+  , m_retransmissions (0)
+  , m_maxReorder (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_rtt = CreateObject<RttMeanDeviation> ();
+  m_retxCheck.SetFunction (MakeCallback (&SegmentFetcher::CheckRetxTimeout, this));
+}
+
+const LatencyHistogram &
+SegmentFetcher::GetCompletionHistogram () const
+{
+  return m_completionHistogram;
+}
+
+void
+SegmentFetcher::StartApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  App::StartApplication ();
+
+  m_object = m_startObject;
+  m_objectsFetched = 0;
+  StartObject ();
+}
+
+void
+SegmentFetcher::StopApplication ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_retxCheck.Cancel ();
+  Simulator::Cancel (m_startEvent);
+
+  App::StopApplication ();
+}
+
+void
+SegmentFetcher::StartObject ()
+{
+  if (!m_active) return;
+
+  NS_LOG_DEBUG ("Start fetching object " << m_object);
+
+  m_objectStart = Simulator::Now ();
+  m_received.assign ((m_segments + 63) / 64, 0);
+  m_inFlight.assign ((m_segments + 63) / 64, 0);
+  m_inFlightCount = 0;
+  m_nextSegment = 0;
+  m_inOrder = 0;
+  m_receivedCount = 0;
+  m_retransmissions = 0;
+  m_maxReorder = 0;
+  m_sendOrder.clear ();
+  m_retxQueue.clear ();
+
+  m_rtt->ClearSent (); // segment numbers of the previous object are reused
+
+  FillPipeline ();
+}
+
+void
+SegmentFetcher::FillPipeline ()
+{
+  InterestBatch batch;
+
+  while (m_inFlightCount < m_pipelineDepth)
+    {
+      uint32_t segment;
+      if (!m_retxQueue.empty ())
+        {
+          segment = m_retxQueue.front ();
+          m_retxQueue.pop_front ();
+          if (Test (m_received, segment))
+            continue; // Data arrived after timeout
+
+          m_retransmissions++;
+        }
+      else if (m_nextSegment < m_segments)
+        {
+          segment = m_nextSegment++;
+        }
+      else
+        break;
+
+      Ptr<NameComponents> name = Create<NameComponents> (m_prefix);
+      (*name) (m_object) (segment);
+
+      Ptr<InterestHeader> interestHeader = Create<InterestHeader> ();
+      interestHeader->SetNonce            (m_rand.GetValue ());
+      interestHeader->SetName             (name);
+      interestHeader->SetInterestLifetime (m_interestLifeTime);
+
+      NS_LOG_INFO ("> Interest for " << m_object << "/" << segment);
+
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (*interestHeader);
+      batch.push_back (std::make_pair (interestHeader, packet));
+
+      Set (m_inFlight, segment, true);
+      m_inFlightCount++;
+      m_sendOrder.push_back (std::make_pair (segment, Simulator::Now ()));
+      m_rtt->SentSeq (SequenceNumber32 (segment), 1);
+    }
+
+  if (!batch.empty ())
+    {
+      SendInterests (batch);
+      ScheduleRetxCheck ();
+    }
+}
+
+void
+SegmentFetcher::ScheduleRetxCheck ()
+{
+  // drop entries of segments that have been received
+  while (!m_sendOrder.empty () && !Test (m_inFlight, m_sendOrder.front ().first))
+    m_sendOrder.pop_front ();
+
+  if (m_sendOrder.empty ())
+    return;
+
+  m_retxCheck.Arm (m_sendOrder.front ().second + m_rtt->RetransmitTimeout ());
+}
+
+void
+SegmentFetcher::CheckRetxTimeout ()
+{
+  Time now = Simulator::Now ();
+  Time rto = m_rtt->RetransmitTimeout ();
+
+  bool timedOut = false;
+  while (!m_sendOrder.empty ())
+    {
+      uint32_t segment = m_sendOrder.front ().first;
+      if (!Test (m_inFlight, segment))
+        {
+          m_sendOrder.pop_front (); // received
+          continue;
+        }
+
+      if (m_sendOrder.front ().second + rto > now)
+        break; // all later Interests were sent later
+
+      NS_LOG_DEBUG ("Timeout for " << m_object << "/" << segment);
+      m_sendOrder.pop_front ();
+      Set (m_inFlight, segment, false);
+      m_inFlightCount--;
+      m_retxQueue.push_back (segment);
+      m_rtt->SentSeq (SequenceNumber32 (segment), 1); // make sure to disable RTT calculation for this sample
+      timedOut = true;
+    }
+
+  if (timedOut)
+    {
+      m_rtt->IncreaseMultiplier (); // once per batch of timeouts
+      FillPipeline ();
+    }
+
+  ScheduleRetxCheck ();
+}
+
+bool
+SegmentFetcher::ParseName (const NameComponents &name, uint32_t &object, uint32_t &segment) const
+{
+  const std::list<std::string> &components = name.GetComponents ();
+  if (components.size () < 2)
+    return false;
+
+  std::list<std::string>::const_reverse_iterator component = components.rbegin ();
+  try
+    {
+      segment = boost::lexical_cast<uint32_t> (*component);
+      component++;
+      object = boost::lexical_cast<uint32_t> (*component);
+    }
+  catch (const boost::bad_lexical_cast &)
+    {
+      return false;
+    }
+  return true;
+}
+
+void
+SegmentFetcher::OnContentObject (const Ptr<const ContentObjectHeader> &contentObject,
+                                 Ptr<Packet> payload)
+{
+  if (!m_active) return;
+
+  App::OnContentObject (contentObject, payload); // tracing inside
+
+  uint32_t object, segment;
+  if (!ParseName (contentObject->GetName (), object, segment))
+    {
+      NS_LOG_DEBUG ("Ignore " << contentObject->GetName () << " (not a segment name)");
+      return;
+    }
+
+  if (object != m_object || segment >= m_segments || Test (m_received, segment))
+    {
+      NS_LOG_DEBUG ("Ignore " << object << "/" << segment << " (old object or duplicate)");
+      return;
+    }
+
+  NS_LOG_INFO ("< DATA for " << object << "/" << segment);
+
+  Set (m_received, segment, true);
+  m_receivedCount++;
+
+  if (Test (m_inFlight, segment))
+    {
+      Set (m_inFlight, segment, false);
+      m_inFlightCount--;
+    }
+  m_rtt->AckSeq (SequenceNumber32 (segment));
+
+  while (m_inOrder < m_segments && Test (m_received, m_inOrder))
+    m_inOrder++;
+  m_maxReorder = std::max (m_maxReorder, m_receivedCount - m_inOrder);
+
+  if (m_inOrder < m_segments)
+    {
+      FillPipeline ();
+      return;
+    }
+
+  // object is complete
+  Time completion = Simulator::Now () - m_objectStart;
+  NS_LOG_DEBUG ("Object " << m_object << " completed in " << completion.ToDouble (Time::S) << "s");
+
+  m_completionHistogram.Record (completion);
+  m_objectCompleted (m_object, completion, m_segments, m_retransmissions, m_maxReorder);
+
+  m_retxCheck.Cancel ();
+  m_sendOrder.clear ();
+  m_retxQueue.clear ();
+
+  m_objectsFetched++;
+  m_object++;
+  if (m_objectCount == 0 || m_objectsFetched < m_objectCount)
+    {
+      m_startEvent = Simulator::Schedule (m_interval, &SegmentFetcher::StartObject, this);
+    }
+}
+
+void
+SegmentFetcher::OnNack (const Ptr<const InterestHeader> &interest, Ptr<Packet> packet)
+{
+  if (!m_active) return;
+
+  App::OnNack (interest, packet); // tracing inside
+
+  uint32_t object, segment;
+  if (!ParseName (interest->GetName (), object, segment) ||
+      object != m_object || segment >= m_segments || !Test (m_inFlight, segment))
+    {
+      NS_LOG_DEBUG ("Ignore NACK for " << interest->GetName ());
+      return;
+    }
+
+  NS_LOG_INFO ("< NACK for " << object << "/" << segment << ", type " << interest->GetNack ());
+
+  // The entry would otherwise be taken as the send time of the retransmission.  NACKs are rare and
+  // m_sendOrder holds about PipelineDepth entries, so linear search is fine
+  for (std::deque<std::pair<uint32_t, Time> >::iterator entry = m_sendOrder.begin ();
+       entry != m_sendOrder.end ();
+       entry++)
+    {
+      if (entry->first == segment)
+        {
+          m_sendOrder.erase (entry);
+          break;
+        }
+    }
+
+  Set (m_inFlight, segment, false);
+  m_inFlightCount--;
+  m_retxQueue.push_back (segment);
+  m_rtt->SentSeq (SequenceNumber32 (segment), 1); // make sure to disable RTT calculation for this sample
+  m_rtt->IncreaseMultiplier ();
+
+  FillPipeline ();
+  ScheduleRetxCheck ();
+}
+
+} // namespace ndn
+} // namespace ns3
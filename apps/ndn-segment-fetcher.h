@@ -0,0 +1,184 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_SEGMENT_FETCHER_H
+#define NDN_SEGMENT_FETCHER_H
+
+#include "ndn-app.h"
+#include "ns3/random-variable.h"
+#include "ns3/ndn-name-components.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/retx-timer.h"
+#include "ns3/traced-callback.h"
+#include "ns3/latency-histogram.h"
+#include "../../internet/model/rtt-estimator.h"
+
+#include <vector>
+#include <deque>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * \brief Ndn application that fetches objects consisting of multiple segments
+ *
+ * Segment s of object o is requested with name Prefix/o/s.  Up to PipelineDepth Interests are kept
+ * in flight.  Segments can be received in any order, while the application tracks in-order delivery
+ * (the longest prefix of received segments) and the reordering needed to achieve it.  The object is
+ * complete when all segments are received, and its completion time (from the first Interest) is
+ * reported via ObjectCompleted trace and completion time histogram.
+ *
+ * Per-segment state is two bits (received and in-flight); only Interests that are in flight have
+ * additional timeout state.  Lost segments are detected using retransmission timeout; segments
+ * for which a NACK is received are requested again right away.
+ *
+ * Objects are fetched one after another, with Interval between completion of one object
+ * and start of the next one.
+ */
+class SegmentFetcher: public App
+{
+public:
+  static TypeId GetTypeId ();
+
+  SegmentFetcher ();
+
+  // From App
+  virtual void
+  OnContentObject (const Ptr<const ContentObjectHeader> &contentObject,
+                   Ptr<Packet> payload);
+
+  virtual void
+  OnNack (const Ptr<const InterestHeader> &interest, Ptr<Packet> packet);
+
+  /**
+   * \brief Histogram of object completion times
+   */
+  const LatencyHistogram &
+  GetCompletionHistogram () const;
+
+  /**
+   * \brief TracedCallback signature for ObjectCompleted trace
+   *
+   * Parameters: object id, completion time, number of segments, number of retransmissions,
+   * maximum number of segments received ahead of in-order delivery point
+   */
+  typedef TracedCallback<uint32_t, Time, uint32_t, uint32_t, uint32_t> ObjectCompletedCallback;
+
+protected:
+  // from App
+  virtual void
+  StartApplication ();
+
+  virtual void
+  StopApplication ();
+
+private:
+  /**
+   * \brief Reset per-object state and start fetching the next object
+   */
+  void
+  StartObject ();
+
+  /**
+   * \brief Send Interests until the pipeline is full
+   */
+  void
+  FillPipeline ();
+
+  /**
+   * \brief Process expired Interests and schedule the check for the next one
+   */
+  void
+  CheckRetxTimeout ();
+
+  void
+  ScheduleRetxCheck ();
+
+  /**
+   * \brief Get object id and segment number from the last two components of the name
+   * \returns false if the name has less than two components or they are not numbers
+   */
+  bool
+  ParseName (const NameComponents &name, uint32_t &object, uint32_t &segment) const;
+
+  inline bool
+  Test (const std::vector<uint64_t> &bitmap, uint32_t segment) const;
+
+  inline void
+  Set (std::vector<uint64_t> &bitmap, uint32_t segment, bool value);
+
+private:
+  NameComponents m_prefix;
+  uint32_t m_segments;       ///< \brief Number of segments in each object
+  uint32_t m_pipelineDepth;  ///< \brief Maximum number of Interests in flight
+  uint32_t m_startObject;
+  uint32_t m_objectCount;    ///< \brief Number of objects to fetch (0 for unlimited)
+  Time     m_interval;       ///< \brief Time between completion of an object and start of the next one
+  Time     m_interestLifeTime;
+
+  UniformVariable   m_rand; ///< @brief nonce generator
+  Ptr<RttEstimator> m_rtt;
+
+  // per-object state
+  uint32_t m_object;          ///< \brief Id of the object being fetched
+  uint32_t m_objectsFetched;
+  Time     m_objectStart;
+  std::vector<uint64_t> m_received; ///< \brief Bitmap of received segments
+  std::vector<uint64_t> m_inFlight; ///< \brief Bitmap of segments with Interest in flight
+  uint32_t m_inFlightCount;
+  uint32_t m_nextSegment;     ///< \brief Next segment that has never been requested
+  uint32_t m_inOrder;         ///< \brief All segments before this one are received
+  uint32_t m_receivedCount;
+  uint32_t m_retransmissions;
+  uint32_t m_maxReorder;      ///< \brief Maximum number of segments received beyond in-order point
+
+  /**
+   * \brief Interests in flight in order of transmission (segment, send time)
+   *
+   * Entries of segments that have been received are removed lazily when they reach the front
+   */
+  std::deque<std::pair<uint32_t, Time> > m_sendOrder;
+  std::deque<uint32_t> m_retxQueue; ///< \brief Segments that timed out and should be requested again
+  RetxTimer m_retxCheck;
+  EventId m_startEvent;
+
+  LatencyHistogram m_completionHistogram;
+  ObjectCompletedCallback m_objectCompleted;
+};
+
+inline bool
+SegmentFetcher::Test (const std::vector<uint64_t> &bitmap, uint32_t segment) const
+{
+  return (bitmap[segment >> 6] >> (segment & 63)) & 1;
+}
+
+inline void
+SegmentFetcher::Set (std::vector<uint64_t> &bitmap, uint32_t segment, bool value)
+{
+  if (value)
+    bitmap[segment >> 6] |= (static_cast<uint64_t> (1) << (segment & 63));
+  else
+    bitmap[segment >> 6] &= ~(static_cast<uint64_t> (1) << (segment & 63));
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEGMENT_FETCHER_H
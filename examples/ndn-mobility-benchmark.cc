@@ -0,0 +1,544 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.MobilityBenchmark");
+
+/**
+ * This program runs a parameterized producer mobility scenario and reports how well
+ * Interests follow the producer, so locator-based forwarding changes can be compared
+ * on the same workload:
+ *
+ *                                  core
+ *                      /                          \
+ *                   agg 0          ...           agg G-1
+ *                 /       \                     /       \
+ *             ap 0  ...  ap K-1         ...   ...       ap M-1
+ *               |                                          |
+ *             home    ~~ Stations (wifi, random walk) ~~  mobile
+ *
+ * Access points (Aps) are placed on a line, ApsPerRouter of them are connected to each
+ * aggregation router.  Stations move across all access points and consumers
+ * (ns3::ndn::ConsumerCbr) on random stations request /prefix/<seq>, each consumer its own
+ * sequence range.
+ *
+ * The producer is attached behind access point HomeAp.  At DetachTime it leaves its home
+ * attachment, where ns3::ndn::ProducerAgent takes over the prefix, and after HandoffDelay
+ * (HandoffTime of the agent) it is available behind TargetAp with locator /ap<TargetAp>.
+ * From then on, the agent re-expresses Interests for the prefix with the locator (and
+ * Interests buffered during the handoff, if BufferInterests is set).  If LocatorCache is
+ * not 0, access points learn the locator from Data and stamp it on Interests themselves
+ * (see LocatorCacheSize attribute of ns3::ndn::ForwardingStrategy).
+ *
+ * Output is a single tab-separated line (preceded by a header line):
+ *
+ *   Aps Stations Consumers Seed LocatorCache Requested Delivered Lost LossRatio
+ *   Retransmissions HandoffLatencyMs PathStretch AgentInterests StampedInterests WallSeconds
+ *
+ * Requested is the number of distinct Interests sent by consumers, excluding ones first sent
+ * later than one Interest lifetime before the end of the simulation, and Lost is the number of
+ * those that have never been satisfied.  Retransmissions is the number of Interests sent again
+ * by consumers after a timeout.  HandoffLatencyMs is the time between DetachTime and the first
+ * Data from the new attachment point delivered to a consumer.  PathStretch is the number of
+ * transmissions of delivered Data over links (including duplicates sent by the agent's node)
+ * divided by the total length of shortest paths between consumers' access points and the
+ * attachment point that served the Data.  AgentInterests is the number of Interests that reached
+ * the agent, and StampedInterests is the number of Interests stamped with locator by access points.
+ *
+ * Example:
+ *
+ *     ./waf --run="ndn-mobility-benchmark --Aps=8 --Stations=20 --Consumers=10 --LocatorCache=100"
+ */
+
+/**
+ * @brief Wired part of the scenario: access points, aggregation routers, and the core router
+ */
+struct Tree
+{
+  Ptr<Node> core;
+  NodeContainer aggregation;
+  NodeContainer accessPoints;
+  uint32_t apsPerRouter;
+
+  NetDeviceContainer apUplinks;     ///< @brief access point side of access point links, by access point
+  NetDeviceContainer aggDownlinks;  ///< @brief router side of access point links, by access point
+  NetDeviceContainer aggUplinks;    ///< @brief router side of core links, by aggregation router
+  NetDeviceContainer coreDownlinks; ///< @brief core side of core links, by aggregation router
+};
+
+static Tree
+BuildTree (uint32_t aps, uint32_t apsPerRouter)
+{
+  NS_ABORT_MSG_IF (aps < 2, "At least 2 access points are required");
+  NS_ABORT_MSG_IF (apsPerRouter == 0, "ApsPerRouter should be positive");
+
+  Tree tree;
+  tree.apsPerRouter = apsPerRouter;
+  tree.core = CreateObject<Node> ();
+  tree.aggregation.Create ((aps + apsPerRouter - 1) / apsPerRouter);
+  tree.accessPoints.Create (aps);
+
+  PointToPointHelper p2p;
+  for (uint32_t g = 0; g < tree.aggregation.GetN (); g++)
+    {
+      NetDeviceContainer link = p2p.Install (tree.aggregation.Get (g), tree.core);
+      tree.aggUplinks.Add (link.Get (0));
+      tree.coreDownlinks.Add (link.Get (1));
+    }
+  for (uint32_t i = 0; i < aps; i++)
+    {
+      NetDeviceContainer link = p2p.Install (tree.accessPoints.Get (i), tree.aggregation.Get (i / apsPerRouter));
+      tree.apUplinks.Add (link.Get (0));
+      tree.aggDownlinks.Add (link.Get (1));
+    }
+  return tree;
+}
+
+static Ptr<ndn::Face>
+GetFace (Ptr<NetDevice> device)
+{
+  return device->GetNode ()->GetObject<ndn::L3Protocol> ()->GetFaceByNetDevice (device);
+}
+
+/**
+ * @brief Install routes for `prefix' towards `attachment' device of access point `ap'
+ */
+static void
+AddTreeRoutes (const Tree &tree, const std::string &prefix, uint32_t ap, Ptr<NetDevice> attachment)
+{
+  uint32_t group = ap / tree.apsPerRouter;
+  for (uint32_t i = 0; i < tree.accessPoints.GetN (); i++)
+    {
+      Ptr<NetDevice> device = (i == ap) ? attachment : tree.apUplinks.Get (i);
+      ndn::StackHelper::AddRoute (tree.accessPoints.Get (i), prefix, GetFace (device), 0);
+    }
+  for (uint32_t g = 0; g < tree.aggregation.GetN (); g++)
+    {
+      Ptr<NetDevice> device = (g == group) ? tree.aggDownlinks.Get (ap) : tree.aggUplinks.Get (g);
+      ndn::StackHelper::AddRoute (tree.aggregation.Get (g), prefix, GetFace (device), 0);
+    }
+  ndn::StackHelper::AddRoute (tree.core, prefix, GetFace (tree.coreDownlinks.Get (group)), 0);
+}
+
+/**
+ * @brief Length of the shortest path between a station at access point `from' and
+ * a node attached to access point `to'
+ */
+static uint32_t
+GetShortestHops (const Tree &tree, uint32_t from, uint32_t to)
+{
+  uint32_t hops = 2; // station -- access point, access point -- attached node
+  if (from == to)
+    return hops;
+  if (from / tree.apsPerRouter == to / tree.apsPerRouter)
+    return hops + 2;
+  return hops + 4;
+}
+
+/**
+ * @brief Collects per-Interest outcome from consumer and forwarding strategy traces
+ */
+class MobilityStats
+{
+public:
+  MobilityStats (const Tree &tree, uint32_t homeAp, uint32_t targetAp, Time detachTime)
+    : m_tree (tree)
+    , m_homeAp (homeAp)
+    , m_targetAp (targetAp)
+    , m_detachTime (detachTime)
+    , m_handoffLatency (Seconds (-1))
+    , m_deliveredHops (0)
+    , m_shortestHops (0)
+    , m_agentInterests (0)
+  {
+    for (uint32_t i = 0; i < tree.accessPoints.GetN (); i++)
+      {
+        Ptr<ndn::L3Protocol> ndn = tree.accessPoints.Get (i)->GetObject<ndn::L3Protocol> ();
+        for (uint32_t faceId = 0; faceId < ndn->GetNFaces (); faceId++)
+          {
+            Ptr<ndn::NetDeviceFace> face = DynamicCast<ndn::NetDeviceFace> (ndn->GetFace (faceId));
+            if (face != 0 && DynamicCast<WifiNetDevice> (face->GetNetDevice ()) != 0)
+              m_wifiFaces [PeekPointer (face)] = i;
+          }
+      }
+  }
+
+  void
+  SentInterest (Ptr<const ndn::InterestHeader> header, Ptr<ndn::App>, Ptr<ndn::Face>)
+  {
+    Request &request = m_requests [boost::lexical_cast<std::string> (header->GetName ())];
+    if (request.m_sent == 0)
+      request.m_firstSent = Simulator::Now ();
+    request.m_sent ++;
+  }
+
+  void
+  ReceivedData (Ptr<const ndn::ContentObjectHeader> header, Ptr<const Packet>, Ptr<ndn::App>, Ptr<ndn::Face>)
+  {
+    std::string name = boost::lexical_cast<std::string> (header->GetName ());
+    std::map<std::string, Request>::iterator request = m_requests.find (name);
+    if (request == m_requests.end () || request->second.m_received)
+      return;
+    request->second.m_received = true;
+
+    bool fromTarget = header->GetPosition () >= 0;
+    if (fromTarget && m_handoffLatency < Seconds (0) && Simulator::Now () >= m_detachTime)
+      m_handoffLatency = Simulator::Now () - m_detachTime;
+
+    std::map<std::string, DataPath>::iterator path = m_paths.find (name);
+    if (path == m_paths.end ())
+      return;
+    if (path->second.m_ap >= 0) // otherwise satisfied by the station itself
+      {
+        m_deliveredHops += path->second.m_hops;
+        m_shortestHops += GetShortestHops (m_tree, path->second.m_ap, fromTarget ? m_targetAp : m_homeAp);
+      }
+    m_paths.erase (path);
+  }
+
+  void
+  ForwardedData (Ptr<const ndn::ContentObjectHeader> header, Ptr<const Packet>, bool, Ptr<const ndn::Face> face)
+  {
+    if (DynamicCast<const ndn::AppFace> (face) != 0)
+      return; // delivery to application on the same node
+
+    DataPath &path = m_paths [boost::lexical_cast<std::string> (header->GetName ())];
+    path.m_hops ++;
+
+    std::map<const ndn::Face*, uint32_t>::const_iterator ap = m_wifiFaces.find (PeekPointer (face));
+    if (ap != m_wifiFaces.end ())
+      path.m_ap = ap->second;
+  }
+
+  void
+  AgentInterest (Ptr<const ndn::InterestHeader>, Ptr<ndn::App>, Ptr<ndn::Face>)
+  {
+    m_agentInterests ++;
+  }
+
+  void
+  Print (std::ostream &os, Time lastRequest) const
+  {
+    uint64_t requested = 0;
+    uint64_t lost = 0;
+    uint64_t retransmissions = 0;
+    for (std::map<std::string, Request>::const_iterator request = m_requests.begin ();
+         request != m_requests.end ();
+         request++)
+      {
+        retransmissions += request->second.m_sent - 1;
+        if (request->second.m_firstSent > lastRequest)
+          continue;
+
+        requested ++;
+        if (!request->second.m_received)
+          lost ++;
+      }
+
+    os << requested << "\t"
+       << requested - lost << "\t"
+       << lost << "\t"
+       << (requested > 0 ? 1.0 * lost / requested : 0) << "\t"
+       << retransmissions << "\t"
+       << (m_handoffLatency >= Seconds (0) ? m_handoffLatency.ToDouble (Time::MS) : -1) << "\t"
+       << (m_shortestHops > 0 ? 1.0 * m_deliveredHops / m_shortestHops : 0) << "\t"
+       << m_agentInterests;
+  }
+
+private:
+  struct Request
+  {
+    Request () : m_sent (0), m_received (false) { }
+
+    Time m_firstSent;
+    uint32_t m_sent;
+    bool m_received;
+  };
+
+  struct DataPath
+  {
+    DataPath () : m_hops (0), m_ap (-1) { }
+
+    uint32_t m_hops;
+    int32_t m_ap; ///< @brief access point that delivered Data to the station
+  };
+
+  const Tree &m_tree;
+  uint32_t m_homeAp;
+  uint32_t m_targetAp;
+  Time m_detachTime;
+
+  std::map<std::string, Request> m_requests;
+  std::map<std::string, DataPath> m_paths;
+  std::map<const ndn::Face*, uint32_t> m_wifiFaces;
+
+  Time m_handoffLatency;
+  uint64_t m_deliveredHops;
+  uint64_t m_shortestHops;
+  uint64_t m_agentInterests;
+};
+
+static NodeContainer
+PickRandom (const NodeContainer &nodes, uint32_t count, UniformVariable &rand)
+{
+  std::vector< Ptr<Node> > pool (nodes.Begin (), nodes.End ());
+  NodeContainer picked;
+  for (uint32_t i = 0; i < count && !pool.empty (); i++)
+    {
+      uint32_t index = rand.GetInteger (0, pool.size () - 1);
+      picked.Add (pool [index]);
+      pool [index] = pool.back ();
+      pool.pop_back ();
+    }
+  return picked;
+}
+
+int
+main (int argc, char *argv[])
+{
+  Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("100Mbps"));
+  Config::SetDefault ("ns3::PointToPointChannel::Delay", StringValue ("5ms"));
+  Config::SetDefault ("ns3::DropTailQueue::MaxPackets", StringValue ("100"));
+
+  uint32_t aps = 4;
+  uint32_t apsPerRouter = 2;
+  uint32_t stations = 10;
+  uint32_t consumers = 5;
+  double frequency = 50.0;
+  double speed = 10.0;
+  uint32_t homeAp = 0;
+  int32_t targetAp = -1;
+  Time detachTime = Seconds (5.0);
+  Time handoffDelay = MilliSeconds (200);
+  bool bufferInterests = true;
+  double replayRate = 1000.0;
+  uint32_t locatorCache = 0;
+  Time interestLifetime = Seconds (1.0);
+  uint32_t seed = 1;
+  Time finishTime = Seconds (15.0);
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue ("Aps", "Number of access points", aps);
+  cmd.AddValue ("ApsPerRouter", "Number of access points connected to each aggregation router", apsPerRouter);
+  cmd.AddValue ("Stations", "Number of mobile stations", stations);
+  cmd.AddValue ("Consumers", "Number of consumers (on random stations)", consumers);
+  cmd.AddValue ("Frequency", "Interests per second sent by each consumer", frequency);
+  cmd.AddValue ("Speed", "Speed of mobile stations, m/s", speed);
+  cmd.AddValue ("HomeAp", "Access point of the producer before the handoff", homeAp);
+  cmd.AddValue ("TargetAp", "Access point of the producer after the handoff (-1 for the last one)", targetAp);
+  cmd.AddValue ("DetachTime", "Time when the producer leaves its home attachment point", detachTime);
+  cmd.AddValue ("HandoffDelay", "Time until the producer is available at the target attachment point", handoffDelay);
+  cmd.AddValue ("BufferInterests", "Buffer Interests at the agent during the handoff (IsOpenCache)", bufferInterests);
+  cmd.AddValue ("ReplayRate", "Rate of re-expression of buffered Interests (0 for all at once)", replayRate);
+  cmd.AddValue ("LocatorCache", "Size of locator caches on access points (0 disables)", locatorCache);
+  cmd.AddValue ("LifeTime", "Lifetime of consumer Interests", interestLifetime);
+  cmd.AddValue ("Seed", "Run number of the random number generator", seed);
+  cmd.AddValue ("Finish", "Simulation time", finishTime);
+  cmd.AddValue ("Output", "Output file (- for standard output)", output);
+  cmd.Parse (argc, argv);
+
+  if (targetAp < 0)
+    targetAp = aps - 1;
+  NS_ABORT_MSG_IF (homeAp >= aps || static_cast<uint32_t> (targetAp) >= aps || homeAp == static_cast<uint32_t> (targetAp),
+                   "HomeAp and TargetAp should be different access points");
+
+  SeedManager::SetSeed (1);
+  SeedManager::SetRun (seed);
+  UniformVariable rand;
+
+  std::string prefix = "/prefix";
+  std::string locator = "/ap" + boost::lexical_cast<std::string> (targetAp);
+
+  Tree tree = BuildTree (aps, apsPerRouter);
+
+  // home and target attachment points of the producer
+  Ptr<Node> home = CreateObject<Node> ();
+  Ptr<Node> mobile = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  NetDeviceContainer homeLink = p2p.Install (tree.accessPoints.Get (homeAp), home);
+  NetDeviceContainer mobileLink = p2p.Install (tree.accessPoints.Get (targetAp), mobile);
+
+  NodeContainer stationNodes;
+  stationNodes.Create (stations);
+
+  double apDistance = 100.0;
+  double length = (aps - 1) * apDistance;
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> apPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < aps; i++)
+    apPositions->Add (Vector (i * apDistance, 0.0, 0.0));
+  mobility.SetPositionAllocator (apPositions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (tree.accessPoints);
+
+  Ptr<ListPositionAllocator> stationPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < stations; i++)
+    stationPositions->Add (Vector (rand.GetValue (0, length), rand.GetValue (0, 20.0), 0.0));
+  mobility.SetPositionAllocator (stationPositions);
+  mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
+                             "Bounds", RectangleValue (Rectangle (0, length, 0, 20.0)),
+                             "Speed", RandomVariableValue (ConstantVariable (speed)),
+                             "Distance", DoubleValue (apDistance));
+  mobility.Install (stationNodes);
+
+  Ssid ssid = Ssid ("NDNAP");
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+
+  WifiHelper wifi = WifiHelper::Default ();
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+  wifiMac.SetType ("ns3::ApWifiMac", "Ssid", SsidValue (ssid));
+  wifi.Install (wifiPhy, wifiMac, tree.accessPoints);
+  wifiMac.SetType ("ns3::StaWifiMac",
+                   "Ssid", SsidValue (ssid),
+                   "ActiveProbing", BooleanValue (false));
+  wifi.Install (wifiPhy, wifiMac, stationNodes);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install (tree.core);
+  ndnHelper.Install (tree.aggregation);
+  ndnHelper.Install (home);
+  ndnHelper.Install (mobile);
+
+  // access points are the edge routers that may rewrite Interests
+  ndn::StackHelper apHelper;
+  apHelper.SetForwardingStrategy ("ns3::ndn::fw::Flooding",
+                                  "LocatorCacheSize", boost::lexical_cast<std::string> (locatorCache));
+  apHelper.Install (tree.accessPoints);
+
+  // stations have a single face, the default route is all they need
+  ndn::StackHelper stationHelper;
+  stationHelper.SetDefaultRoutes (true);
+  stationHelper.Install (stationNodes);
+
+  AddTreeRoutes (tree, prefix, homeAp, homeLink.Get (0));
+  AddTreeRoutes (tree, locator, targetAp, mobileLink.Get (0));
+  // Interests re-expressed by the agent leave the home node towards the locator
+  ndn::StackHelper::AddRoute (home, locator, GetFace (homeLink.Get (1)), 0);
+
+  NodeContainer consumerNodes = PickRandom (stationNodes, consumers, rand);
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix (prefix);
+  consumerHelper.SetAttribute ("Frequency", DoubleValue (frequency));
+  consumerHelper.SetAttribute ("LifeTime", TimeValue (interestLifetime));
+  ApplicationContainer consumerApps;
+  for (uint32_t i = 0; i < consumerNodes.GetN (); i++)
+    {
+      // separate sequence ranges, so Data of different consumers are not aggregated
+      consumerHelper.SetAttribute ("StartSeq", IntegerValue (i * 1000000));
+      ApplicationContainer app = consumerHelper.Install (consumerNodes.Get (i));
+      app.Start (Seconds (rand.GetValue (0, 1.0)));
+      consumerApps.Add (app);
+    }
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix (prefix);
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  ApplicationContainer homeProducer = producerHelper.Install (home);
+  homeProducer.Stop (detachTime);
+
+  producerHelper.SetAttribute ("Locator", StringValue (locator));
+  ApplicationContainer mobileProducer = producerHelper.Install (mobile);
+  mobileProducer.Start (detachTime + handoffDelay);
+
+  ndn::AppHelper agentHelper ("ns3::ndn::ProducerAgent");
+  agentHelper.SetPrefix (prefix);
+  agentHelper.SetAttribute ("Locator", StringValue (locator));
+  agentHelper.SetAttribute ("HandoffTime", TimeValue (handoffDelay));
+  agentHelper.SetAttribute ("IsOpenCache", BooleanValue (bufferInterests));
+  agentHelper.SetAttribute ("ReplayRate", DoubleValue (replayRate));
+  ApplicationContainer agent = agentHelper.Install (home);
+  agent.Start (detachTime);
+
+  MobilityStats stats (tree, homeAp, targetAp, detachTime);
+  for (uint32_t i = 0; i < consumerApps.GetN (); i++)
+    {
+      consumerApps.Get (i)->TraceConnectWithoutContext ("TransmittedInterests",
+                                                        MakeCallback (&MobilityStats::SentInterest, &stats));
+      consumerApps.Get (i)->TraceConnectWithoutContext ("ReceivedContentObjects",
+                                                        MakeCallback (&MobilityStats::ReceivedData, &stats));
+    }
+  agent.Get (0)->TraceConnectWithoutContext ("ReceivedInterests", MakeCallback (&MobilityStats::AgentInterest, &stats));
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<ndn::ForwardingStrategy> strategy = (*node)->GetObject<ndn::ForwardingStrategy> ();
+      if (strategy != 0)
+        strategy->TraceConnectWithoutContext ("OutData", MakeCallback (&MobilityStats::ForwardedData, &stats));
+    }
+
+  Simulator::Stop (finishTime);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t runMs = clock.End ();
+
+  uint64_t stamped = 0;
+  for (uint32_t i = 0; i < aps; i++)
+    stamped += tree.accessPoints.Get (i)->GetObject<ndn::ForwardingStrategy> ()->GetTraceCount ("LocatorStampedInterests");
+
+  std::ofstream file;
+  if (output != "-")
+    file.open (output.c_str (), std::ios::trunc);
+  std::ostream &os = (output != "-") ? file : std::cout;
+
+  os << "Aps" << "\t"
+     << "Stations" << "\t"
+     << "Consumers" << "\t"
+     << "Seed" << "\t"
+     << "LocatorCache" << "\t"
+     << "Requested" << "\t"
+     << "Delivered" << "\t"
+     << "Lost" << "\t"
+     << "LossRatio" << "\t"
+     << "Retransmissions" << "\t"
+     << "HandoffLatencyMs" << "\t"
+     << "PathStretch" << "\t"
+     << "AgentInterests" << "\t"
+     << "StampedInterests" << "\t"
+     << "WallSeconds" << "\n";
+  os << aps << "\t"
+     << stations << "\t"
+     << consumerNodes.GetN () << "\t"
+     << seed << "\t"
+     << locatorCache << "\t";
+  stats.Print (os, finishTime - interestLifetime);
+  os << "\t"
+     << stamped << "\t"
+     << runMs / 1000.0 << std::endl;
+
+  Simulator::Destroy ();
+
+  return 0;
+}
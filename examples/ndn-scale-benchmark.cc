@@ -0,0 +1,435 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/topology-read-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <sys/resource.h>
+
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ScaleBenchmark");
+
+/**
+ * This program runs parameterized scale scenarios and reports how fast the
+ * simulation runs, so builds can be compared on the same workload:
+ *
+ * - grid:       Size x Size grid of point-to-point links (PointToPointGridHelper)
+ * - rocketfuel: Rocketfuel map read from --Topology (ns-3 RocketfuelTopologyReader)
+ * - fattree:    k-ary fat-tree with k = Size: (k/2)^2 core switches, k pods of k/2
+ *               aggregation and k/2 edge switches, and k/2 hosts per edge switch
+ *               (k = 32 yields 9472 nodes)
+ * - wireless:   Size access points connected to a core router, with Stations wifi
+ *               nodes moving across access points (like ry-test.cc)
+ *
+ * Consumers (ns3::ndn::ConsumerCbr) and producers are placed on random nodes (hosts
+ * in fattree).  In wireless, consumers are random stations and producers are
+ * attached to the core router.  All random choices, including the
+ * ones made by applications, are determined by --Seed.
+ *
+ * Output is a single tab-separated line (preceded by a header line):
+ *
+ *   Scenario Nodes Seed SimSeconds SetupSeconds WallSeconds Events EventsPerSecond
+ *   PacketsForwarded PacketsPerSecond PeakRssKb TablesBytes
+ *
+ * SetupSeconds is the wall-clock time of topology construction and route calculation,
+ * WallSeconds is the wall-clock time of Simulator::Run.  Events is the number of events
+ * scheduled while the simulation was running, and PacketsForwarded is the number of
+ * Interests and Data packets sent out by forwarding strategies on all nodes.  PeakRssKb
+ * is the maximum resident set size of the process (including topology construction), and
+ * TablesBytes is the estimate of memory used by PIT, FIB, and content stores of all nodes
+ * at the end of the simulation.
+ *
+ * Example:
+ *
+ *     ./waf --run="ndn-scale-benchmark --Scenario=fattree --Size=32 --Consumers=1000 --Seed=2"
+ */
+
+static void
+Noop ()
+{
+}
+
+/**
+ * @brief Get unique ID that will be assigned to the next scheduled event
+ *
+ * Difference between two values is the number of events scheduled in between
+ */
+static uint32_t
+GetNextEventUid ()
+{
+  EventId event = Simulator::Schedule (Seconds (0), &Noop);
+  Simulator::Remove (event);
+  return event.GetUid ();
+}
+
+static uint64_t
+GetForwardedPackets ()
+{
+  uint64_t packets = 0;
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      Ptr<ndn::ForwardingStrategy> strategy = (*node)->GetObject<ndn::ForwardingStrategy> ();
+      if (strategy == 0)
+        continue;
+
+      packets += strategy->GetTraceCount ("OutInterests") + strategy->GetTraceCount ("OutData");
+    }
+  return packets;
+}
+
+static uint64_t
+GetPeakRssKb ()
+{
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    return 0;
+  return usage.ru_maxrss; // kilobytes on Linux
+}
+
+static NodeContainer
+PickRandom (const NodeContainer &nodes, uint32_t count, UniformVariable &rand)
+{
+  std::vector< Ptr<Node> > pool (nodes.Begin (), nodes.End ());
+  NodeContainer picked;
+  for (uint32_t i = 0; i < count && !pool.empty (); i++)
+    {
+      uint32_t index = rand.GetInteger (0, pool.size () - 1);
+      picked.Add (pool [index]);
+      pool [index] = pool.back ();
+      pool.pop_back ();
+    }
+  return picked;
+}
+
+/**
+ * @brief Build Size x Size grid, return all nodes as candidates for applications
+ */
+static NodeContainer
+BuildGrid (uint32_t size)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid (size, size, p2p);
+
+  NodeContainer nodes;
+  for (uint32_t row = 0; row < size; row++)
+    for (uint32_t col = 0; col < size; col++)
+      nodes.Add (grid.GetNode (row, col));
+  return nodes;
+}
+
+/**
+ * @brief Read Rocketfuel map, return all nodes as candidates for applications
+ */
+static NodeContainer
+BuildRocketfuel (const std::string &topology)
+{
+  TopologyReaderHelper topologyHelper;
+  topologyHelper.SetFileName (topology);
+  topologyHelper.SetFileType ("Rocketfuel");
+  Ptr<TopologyReader> reader = topologyHelper.GetTopologyReader ();
+  NS_ABORT_MSG_IF (reader == 0, "Cannot read Rocketfuel topology from [" << topology << "]");
+
+  NodeContainer nodes = reader->Read ();
+  NS_ABORT_MSG_IF (nodes.GetN () == 0, "Rocketfuel topology [" << topology << "] is empty");
+
+  PointToPointHelper p2p;
+  for (TopologyReader::ConstLinksIterator link = reader->LinksBegin ();
+       link != reader->LinksEnd ();
+       link++)
+    {
+      p2p.Install (link->GetFromNode (), link->GetToNode ());
+    }
+  return nodes;
+}
+
+/**
+ * @brief Build k-ary fat-tree, return hosts as candidates for applications
+ */
+static NodeContainer
+BuildFatTree (uint32_t k)
+{
+  NS_ABORT_MSG_IF (k < 2 || k % 2 != 0, "Fat-tree requires even k >= 2");
+  uint32_t half = k / 2;
+
+  PointToPointHelper p2p;
+
+  NodeContainer core;
+  core.Create (half * half);
+
+  NodeContainer hosts;
+  for (uint32_t pod = 0; pod < k; pod++)
+    {
+      NodeContainer aggregation;
+      aggregation.Create (half);
+      NodeContainer edge;
+      edge.Create (half);
+
+      for (uint32_t a = 0; a < half; a++)
+        {
+          // aggregation switch `a' connects to core switches [a*k/2, (a+1)*k/2)
+          for (uint32_t c = 0; c < half; c++)
+            p2p.Install (aggregation.Get (a), core.Get (a * half + c));
+
+          for (uint32_t e = 0; e < half; e++)
+            p2p.Install (aggregation.Get (a), edge.Get (e));
+        }
+
+      for (uint32_t e = 0; e < half; e++)
+        {
+          NodeContainer edgeHosts;
+          edgeHosts.Create (half);
+          for (uint32_t h = 0; h < half; h++)
+            p2p.Install (edge.Get (e), edgeHosts.Get (h));
+          hosts.Add (edgeHosts);
+        }
+    }
+  return hosts;
+}
+
+int
+main (int argc, char *argv[])
+{
+  Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("100Mbps"));
+  Config::SetDefault ("ns3::PointToPointChannel::Delay", StringValue ("5ms"));
+  Config::SetDefault ("ns3::DropTailQueue::MaxPackets", StringValue ("100"));
+
+  std::string scenario = "grid";
+  std::string topology = "";
+  std::string output = "-";
+  uint32_t size = 10;
+  uint32_t stations = 10;
+  uint32_t consumers = 10;
+  uint32_t producers = 1;
+  double frequency = 100.0;
+  double speed = 20.0;
+  uint32_t csSize = 100;
+  uint32_t seed = 1;
+  Time finishTime = Seconds (10.0);
+
+  CommandLine cmd;
+  cmd.AddValue ("Scenario", "Scenario: grid, rocketfuel, fattree, or wireless", scenario);
+  cmd.AddValue ("Size", "Grid side (grid), k (fattree), or number of access points (wireless)", size);
+  cmd.AddValue ("Topology", "Rocketfuel map file (rocketfuel)", topology);
+  cmd.AddValue ("Stations", "Number of mobile stations (wireless)", stations);
+  cmd.AddValue ("Consumers", "Number of consumers", consumers);
+  cmd.AddValue ("Producers", "Number of producers", producers);
+  cmd.AddValue ("Frequency", "Interests per second sent by each consumer", frequency);
+  cmd.AddValue ("Speed", "Speed of mobile stations, m/s (wireless)", speed);
+  cmd.AddValue ("CsSize", "Maximum number of entries in each content store", csSize);
+  cmd.AddValue ("Seed", "Run number of the random number generator", seed);
+  cmd.AddValue ("Finish", "Simulation time", finishTime);
+  cmd.AddValue ("Output", "Output file (- for standard output)", output);
+  cmd.Parse (argc, argv);
+
+  SeedManager::SetSeed (1);
+  SeedManager::SetRun (seed);
+  UniformVariable rand;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  std::string prefix = "/prefix";
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", boost::lexical_cast<std::string> (csSize));
+
+  NodeContainer candidates;
+  NodeContainer consumerNodes;
+  NodeContainer producerNodes;
+  if (scenario == "grid" || scenario == "rocketfuel" || scenario == "fattree")
+    {
+      if (scenario == "grid")
+        candidates = BuildGrid (size);
+      else if (scenario == "rocketfuel")
+        candidates = BuildRocketfuel (topology);
+      else
+        candidates = BuildFatTree (size);
+
+      ndnHelper.InstallAll ();
+
+      ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+      ndnGlobalRoutingHelper.InstallAll ();
+
+      producerNodes = PickRandom (candidates, producers, rand);
+      consumerNodes = PickRandom (candidates, consumers, rand);
+
+      ndnGlobalRoutingHelper.AddOrigins (prefix, producerNodes);
+      ndnGlobalRoutingHelper.CalculateRoutes ();
+    }
+  else if (scenario == "wireless")
+    {
+      // producers -- core router -- access points ~~~ stations
+      Ptr<Node> router = CreateObject<Node> ();
+      NodeContainer accessPoints;
+      accessPoints.Create (size);
+      producerNodes.Create (producers);
+      NodeContainer stationNodes;
+      stationNodes.Create (stations);
+
+      PointToPointHelper p2p;
+      NetDeviceContainer producerLinks;
+      for (uint32_t i = 0; i < producerNodes.GetN (); i++)
+        producerLinks.Add (p2p.Install (router, producerNodes.Get (i)).Get (0));
+      NetDeviceContainer uplinks;
+      for (uint32_t i = 0; i < accessPoints.GetN (); i++)
+        uplinks.Add (p2p.Install (accessPoints.Get (i), router).Get (0));
+
+      double apDistance = 100.0;
+      MobilityHelper mobility;
+      Ptr<ListPositionAllocator> apPositions = CreateObject<ListPositionAllocator> ();
+      for (uint32_t i = 0; i < accessPoints.GetN (); i++)
+        apPositions->Add (Vector (i * apDistance, 0.0, 0.0));
+      mobility.SetPositionAllocator (apPositions);
+      mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+      mobility.Install (accessPoints);
+
+      Ptr<ListPositionAllocator> stationPositions = CreateObject<ListPositionAllocator> ();
+      for (uint32_t i = 0; i < stationNodes.GetN (); i++)
+        stationPositions->Add (Vector (rand.GetValue (0, size * apDistance), 10.0, 0.0));
+      mobility.SetPositionAllocator (stationPositions);
+      mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+      mobility.Install (stationNodes);
+      for (uint32_t i = 0; i < stationNodes.GetN (); i++)
+        {
+          double direction = (rand.GetValue () < 0.5) ? -1.0 : 1.0;
+          stationNodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ()
+            ->SetVelocity (Vector (direction * speed, 0.0, 0.0));
+        }
+
+      Ssid ssid = Ssid ("NDNAP");
+      YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+      YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+      wifiPhy.SetChannel (wifiChannel.Create ());
+
+      WifiHelper wifi = WifiHelper::Default ();
+      NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+      wifiMac.SetType ("ns3::ApWifiMac", "Ssid", SsidValue (ssid));
+      NetDeviceContainer apDevices = wifi.Install (wifiPhy, wifiMac, accessPoints);
+      wifiMac.SetType ("ns3::StaWifiMac",
+                       "Ssid", SsidValue (ssid),
+                       "ActiveProbing", BooleanValue (false));
+      wifi.Install (wifiPhy, wifiMac, stationNodes);
+
+      ndnHelper.Install (router);
+      ndnHelper.Install (accessPoints);
+      ndnHelper.Install (producerNodes);
+
+      // stations have a single face, the default route is all they need
+      ndn::StackHelper stationHelper;
+      stationHelper.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", boost::lexical_cast<std::string> (csSize));
+      stationHelper.SetDefaultRoutes (true);
+      stationHelper.Install (stationNodes);
+
+      for (uint32_t i = 0; i < accessPoints.GetN (); i++)
+        {
+          Ptr<ndn::L3Protocol> ndn = accessPoints.Get (i)->GetObject<ndn::L3Protocol> ();
+          ndn::StackHelper::AddRoute (accessPoints.Get (i), prefix, ndn->GetFaceByNetDevice (uplinks.Get (i)), 0);
+        }
+      Ptr<ndn::L3Protocol> routerNdn = router->GetObject<ndn::L3Protocol> ();
+      for (uint32_t i = 0; i < producerLinks.GetN (); i++)
+        {
+          ndn::StackHelper::AddRoute (router, prefix, routerNdn->GetFaceByNetDevice (producerLinks.Get (i)), 0);
+        }
+
+      consumerNodes = PickRandom (stationNodes, consumers, rand);
+    }
+  else
+    {
+      std::cerr << "Unknown scenario [" << scenario << "]" << std::endl;
+      return 1;
+    }
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix (prefix);
+  consumerHelper.SetAttribute ("Frequency", DoubleValue (frequency));
+  ApplicationContainer consumerApps = consumerHelper.Install (consumerNodes);
+  for (uint32_t i = 0; i < consumerApps.GetN (); i++)
+    {
+      consumerApps.Get (i)->SetStartTime (Seconds (rand.GetValue (0, 1.0)));
+    }
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix (prefix);
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (producerNodes);
+
+  Simulator::Stop (finishTime);
+
+  int64_t setupMs = clock.End ();
+  clock.Start ();
+  uint32_t firstEvent = GetNextEventUid ();
+
+  Simulator::Run ();
+
+  int64_t runMs = clock.End ();
+  uint64_t events = GetNextEventUid () - firstEvent;
+  uint64_t packets = GetForwardedPackets ();
+  uint64_t tablesBytes = ndn::MemoryUsageHelper::GetTotalUsage (ndn::MemoryUsageHelper::PIT).GetTotal () +
+    ndn::MemoryUsageHelper::GetTotalUsage (ndn::MemoryUsageHelper::FIB).GetTotal () +
+    ndn::MemoryUsageHelper::GetTotalUsage (ndn::MemoryUsageHelper::CS).GetTotal ();
+  uint32_t nodes = NodeList::GetNNodes ();
+
+  Simulator::Destroy ();
+
+  std::ofstream file;
+  if (output != "-")
+    file.open (output.c_str (), std::ios::trunc);
+  std::ostream &os = (output != "-") ? file : std::cout;
+
+  double wallSeconds = runMs / 1000.0;
+  os << "Scenario" << "\t"
+     << "Nodes" << "\t"
+     << "Seed" << "\t"
+     << "SimSeconds" << "\t"
+     << "SetupSeconds" << "\t"
+     << "WallSeconds" << "\t"
+     << "Events" << "\t"
+     << "EventsPerSecond" << "\t"
+     << "PacketsForwarded" << "\t"
+     << "PacketsPerSecond" << "\t"
+     << "PeakRssKb" << "\t"
+     << "TablesBytes" << "\n";
+  os << scenario << "\t"
+     << nodes << "\t"
+     << seed << "\t"
+     << finishTime.ToDouble (Time::S) << "\t"
+     << setupMs / 1000.0 << "\t"
+     << wallSeconds << "\t"
+     << events << "\t"
+     << (wallSeconds > 0 ? events / wallSeconds : 0) << "\t"
+     << packets << "\t"
+     << (wallSeconds > 0 ? packets / wallSeconds : 0) << "\t"
+     << GetPeakRssKb () << "\t"
+     << tablesBytes << std::endl;
+
+  return 0;
+}
@@ -312,6 +312,8 @@ get(const boost::EdgeWeights&, ns3::ndn::GlobalRouter::Incidency &edge)
 {
   if (edge.get<1> () == 0)
     return property_traits< EdgeWeights >::reference (0, 0);
+  else if (!edge.get<1> ()->IsUp ())
+    return property_traits< EdgeWeights >::reference (edge.get<1> (), WeightInf.get<1> ()); // never relaxed
   else
     return property_traits< EdgeWeights >::reference (edge.get<1> (), edge.get<1> ()->GetMetric ());
 }
@@ -25,6 +25,7 @@
 #include "../model/ndn-global-router.h"
 #include "ns3/ndn-name-components.h"
 #include "ns3/ndn-fib.h"
+#include "ns3/ndn-face.h"
 
 #include "ns3/node.h"
 #include "ns3/node-container.h"
@@ -42,6 +43,12 @@
 // #include <boost/graph/graph_concepts.hpp>
 // #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+#include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
 
 #include "boost-graph-ndn-global-routing-helper.h"
 
@@ -210,7 +217,7 @@ GlobalRoutingHelper::AddOrigin (const std::string &prefix, const std::string &no
 }
 
 void
-GlobalRoutingHelper::CalculateRoutes ()
+GlobalRoutingHelper::CalculateRoutes (bool keepTrees/* = false*/)
 {
   /**
    * Implementation of route calculation is heavily based on Boost Graph Library
@@ -283,7 +290,293 @@ GlobalRoutingHelper::CalculateRoutes ()
 		}
 	    }
 	}
+
+      if (keepTrees)
+        source->GetShortestPathTree () = distances;
+      else
+        source->GetShortestPathTree ().clear ();
+    }
+}
+
+/**
+ * @brief Calculate distances from `source' to all vertices of `graph'
+ */
+static void
+CalculateDistances (NdnGlobalRouterGraph &graph, Ptr<GlobalRouter> source, DistancesMap &distances)
+{
+  distances.clear ();
+  dijkstra_shortest_paths (graph, source,
+			   distance_map (boost::ref(distances))
+			   .
+			   distance_inf (WeightInf)
+			   .
+			   distance_zero (WeightZero)
+			   .
+			   distance_compare (boost::WeightCompare ())
+			   .
+			   distance_combine (boost::WeightCombine ())
+			   );
+}
+
+/**
+ * @brief Get distance to `node' (WeightInf if unreachable)
+ */
+static uint32_t
+GetDistance (const DistancesMap &distances, Ptr<GlobalRouter> node)
+{
+  DistancesMap::const_iterator i = distances.find (node);
+  if (i == distances.end ())
+    return WeightInf.get<1> ();
+
+  return std::min<uint32_t> (i->second.get<1> (), WeightInf.get<1> ());
+}
+
+void
+GlobalRoutingHelper::CalculateMultipathRoutes (uint32_t maxNextHops)
+{
+  NS_ASSERT_MSG (maxNextHops > 0, "At least one next hop should be allowed");
+
+  NdnGlobalRouterGraph graph;
+  const uint32_t unreachable = WeightInf.get<1> ();
+
+  // Routes of a node are installed before moving to the next node, so only distances from the node
+  // and from one of its neighbors are kept in memory at a time.  The price is one Dijkstra run per
+  // neighbor in addition to the one for the node itself
+  DistancesMap sourceDistances;
+  DistancesMap neighborDistances;
+  BOOST_FOREACH (const Ptr<GlobalRouter> &source, graph.GetVertices ())
+    {
+      Ptr<Fib> fib = source->GetObject<Fib> ();
+      if (fib == 0)
+        continue; // e.g., channels
+
+      CalculateDistances (graph, source, sourceDistances);
+
+      // up to `maxNextHops' cheapest next hops toward each destination, sorted by cost
+      typedef std::vector< std::pair<uint32_t, Ptr<Face> > > NextHopList;
+      std::map< Ptr<GlobalRouter>, NextHopList > nextHops;
+
+      BOOST_FOREACH (const GlobalRouter::Incidency &edge, source->GetIncidencies ())
+        {
+          Ptr<Face> face = edge.get<1> ();
+          Ptr<GlobalRouter> neighbor = edge.get<2> ();
+          if (face == 0 || !face->IsUp () || neighbor->GetObject<Fib> () == 0)
+            continue;
+
+          CalculateDistances (graph, neighbor, neighborDistances);
+
+          BOOST_FOREACH (const Ptr<GlobalRouter> &destination, graph.GetVertices ())
+            {
+              if (destination == source || destination->GetLocalPrefixes ().empty ())
+                continue;
+
+              uint32_t distance = GetDistance (sourceDistances, destination);
+              uint32_t neighborDistance = GetDistance (neighborDistances, destination);
+              if (distance >= unreachable || neighborDistance >= unreachable)
+                continue;
+
+              uint32_t cost = face->GetMetric () + neighborDistance;
+              if (cost != distance && // not on the shortest path
+                  neighborDistance >= distance) // and not a downstream neighbor (may loop)
+                continue;
+
+              NextHopList &hops = nextHops[destination];
+              std::pair<uint32_t, Ptr<Face> > hop (cost, face);
+              hops.insert (std::upper_bound (hops.begin (), hops.end (), hop), hop);
+              if (hops.size () > maxNextHops)
+                hops.pop_back ();
+            }
+        }
+
+      fib->InvalidateAll ();
+      source->GetShortestPathTree ().clear (); // incremental updates are not supported for multipath routes
+
+      for (std::map< Ptr<GlobalRouter>, NextHopList >::iterator destination = nextHops.begin ();
+           destination != nextHops.end ();
+           destination++)
+        {
+          for (uint32_t i = 0; i < destination->second.size (); i++)
+            {
+              BOOST_FOREACH (const Ptr<const NameComponents> &prefix, destination->first->GetLocalPrefixes ())
+                {
+                  fib->Add (prefix, destination->second[i].second, destination->second[i].first);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check if any of `edges' can be (or become) part of the shortest path tree
+ *
+ * Edge u->v with cost c cannot change the tree if d(u) + c > d(v): it was not used before
+ * failure and will not improve any path after restoration
+ */
+static bool
+IsTreeAffected (Ptr<GlobalRouter> source, const GlobalRouter::ShortestPathTree &tree,
+                const GlobalRouter::IncidencyList &edges)
+{
+  BOOST_FOREACH (const GlobalRouter::Incidency &edge, edges)
+    {
+      GlobalRouter::ShortestPathTree::const_iterator u = tree.find (edge.get<0> ());
+      GlobalRouter::ShortestPathTree::const_iterator v = tree.find (edge.get<2> ());
+      if (u == tree.end () || v == tree.end ())
+        return true; // topology has changed since the tree was saved
+
+      if (u->first != source && u->second.get<0> () == 0)
+        continue; // u is unreachable
+
+      if (u->second.get<1> () + edge.get<1> ()->GetMetric () <= v->second.get<1> ())
+        return true;
+    }
+  return false;
+}
+
+typedef std::map< Ptr<Face>, uint32_t > NextHops;
+
+static void
+AddNextHop (NextHops &hops, const GlobalRouter::ShortestPathTree::mapped_type &route)
+{
+  if (route.get<0> () == 0)
+    return; // unreachable
+
+  NextHops::iterator hop = hops.find (route.get<0> ());
+  if (hop == hops.end ())
+    hops[route.get<0> ()] = route.get<1> ();
+  else
+    hop->second = std::min (hop->second, route.get<1> ());
+}
+
+static void
+GetIncidencies (Ptr<Face> face, GlobalRouter::IncidencyList &edges)
+{
+  Ptr<GlobalRouter> gr = face->GetNode ()->GetObject<GlobalRouter> ();
+  NS_ASSERT_MSG (gr != 0, "GlobalRouter is not installed on the node");
+
+  BOOST_FOREACH (const GlobalRouter::Incidency &edge, gr->GetIncidencies ())
+    {
+      if (edge.get<1> () == face)
+        edges.push_back (edge);
+    }
+}
+
+static void
+UpdateShortestPathTrees (const GlobalRouter::IncidencyList &edges)
+{
+  if (edges.empty ())
+    return;
+
+  NdnGlobalRouterGraph graph;
+
+  // the same prefix can be originated by several nodes, so FIB entry has to be
+  // recalculated from routes to all origins
+  typedef std::map< NameComponents, std::list< Ptr<GlobalRouter> > > OriginsMap;
+  OriginsMap origins;
+  BOOST_FOREACH (const Ptr<GlobalRouter> &gr, graph.GetVertices ())
+    {
+      BOOST_FOREACH (const Ptr<NameComponents> &prefix, gr->GetLocalPrefixes ())
+        {
+          origins[*prefix].push_back (gr);
+        }
+    }
+
+  BOOST_FOREACH (const Ptr<GlobalRouter> &source, graph.GetVertices ())
+    {
+      Ptr<Fib> fib = source->GetObject<Fib> ();
+      if (fib == 0)
+        continue; // e.g., channel
+
+      GlobalRouter::ShortestPathTree &tree = source->GetShortestPathTree ();
+      NS_ASSERT_MSG (!tree.empty (), "CalculateRoutes (true) should be called before UpdateRoutes");
+
+      if (!IsTreeAffected (source, tree, edges))
+        continue;
+
+      NS_LOG_DEBUG ("Recalculating shortest path tree for node " << source->GetObject<Node> ()->GetId ());
+
+      DistancesMap distances;
+      dijkstra_shortest_paths (graph, source,
+			       distance_map (boost::ref(distances))
+			       .
+			       distance_inf (WeightInf)
+			       .
+			       distance_zero (WeightZero)
+			       .
+			       distance_compare (boost::WeightCompare ())
+			       .
+			       distance_combine (boost::WeightCombine ())
+			       );
+
+      std::set<NameComponents> updatedPrefixes;
+      for (DistancesMap::iterator i = distances.begin ();
+	   i != distances.end ();
+	   i++)
+	{
+          if (i->first == source || tree[i->first] == i->second)
+            continue;
+
+          BOOST_FOREACH (const Ptr<const NameComponents> &prefix, i->first->GetLocalPrefixes ())
+            {
+              if (!updatedPrefixes.insert (*prefix).second)
+                continue;
+
+              NextHops oldHops, newHops;
+              BOOST_FOREACH (const Ptr<GlobalRouter> &origin, origins[*prefix])
+                {
+                  if (origin == source)
+                    continue;
+                  AddNextHop (oldHops, tree[origin]);
+                  AddNextHop (newHops, distances[origin]);
+                }
+
+              for (NextHops::iterator hop = oldHops.begin (); hop != oldHops.end (); hop++)
+                {
+                  NextHops::iterator newHop = newHops.find (hop->first);
+                  if (newHop == newHops.end () || newHop->second != hop->second)
+                    fib->Invalidate (prefix, hop->first);
+                }
+
+              for (NextHops::iterator hop = newHops.begin (); hop != newHops.end (); hop++)
+                {
+                  NextHops::iterator oldHop = oldHops.find (hop->first);
+                  if (oldHop == oldHops.end () || oldHop->second != hop->second)
+                    fib->Add (prefix, hop->first, hop->second);
+                }
+            }
+        }
+
+      tree = distances;
+    }
+}
+
+void
+GlobalRoutingHelper::UpdateRoutes (Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (boost::cref (*face));
+
+  GlobalRouter::IncidencyList edges;
+  GetIncidencies (face, edges);
+  UpdateShortestPathTrees (edges);
+}
+
+void
+GlobalRoutingHelper::UpdateRoutes (Ptr<Channel> channel)
+{
+  NS_LOG_FUNCTION (channel->GetId ());
+  NS_ASSERT_MSG (channel->GetNDevices () == 2, "Only point-to-point channels are supported");
+
+  GlobalRouter::IncidencyList edges;
+  for (uint32_t deviceId = 0; deviceId < channel->GetNDevices (); deviceId ++)
+    {
+      Ptr<NetDevice> dev = channel->GetDevice (deviceId);
+      Ptr<L3Protocol> ndn = dev->GetNode ()->GetObject<L3Protocol> ();
+      NS_ASSERT_MSG (ndn != 0, "Ndn stack is not installed on the node");
+
+      Ptr<Face> face = ndn->GetFaceByNetDevice (dev);
+      if (face != 0)
+        GetIncidencies (face, edges);
     }
+  UpdateShortestPathTrees (edges);
 }
 
 
@@ -31,6 +31,8 @@ class Channel;
 
 namespace ndn {
 
+class Face;
+
 /**
  * @ingroup ndn
  * @brief Helper for GlobalRouter interface
@@ -91,9 +93,51 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * @param keepTrees If true, shortest path trees are saved on each GlobalRouter, so routes can
+   *                  later be updated incrementally using UpdateRoutes
+   */
+  void
+  CalculateRoutes (bool keepTrees = false);
+
+  /**
+   * @brief Calculate for every node up to `maxNextHops' loop-free next hops toward each prefix origin
+   *
+   * Next hop (neighbor) n is considered toward destination d only if it is on a shortest path
+   * or is strictly closer to d than the node itself (downstream criterion), which guarantees
+   * absence of loops.  Each next hop is installed with the cost of the best path through it,
+   * and the cheapest `maxNextHops' next hops are selected.
+   *
+   * Routes are calculated one node at a time using distances from the node and from each of its
+   * neighbors, so memory use is linear in the size of the topology
+   *
+   * @param maxNextHops Maximum number of next hops per origin (K)
+   */
+  void
+  CalculateMultipathRoutes (uint32_t maxNextHops);
+
+  /**
+   * @brief Incrementally update routes after `face' was brought down or up (Face::SetUp)
+   *
+   * Only shortest path trees that can be affected by the change are recalculated, and only
+   * routes for which next hop or distance has changed are updated in FIBs.
+   * CalculateRoutes (true) must be called before
+   *
+   * @param face Face which state has changed
+   */
+  void
+  UpdateRoutes (Ptr<Face> face);
+
+  /**
+   * @brief Incrementally update routes after point-to-point `channel' has failed or was restored
+   *
+   * Faces on both sides of the channel should be brought down or up (Face::SetUp) before the call.
+   * CalculateRoutes (true) must be called before
+   *
+   * @param channel Point-to-point channel which state has changed
    */
   void
-  CalculateRoutes ();
+  UpdateRoutes (Ptr<Channel> channel);
 
 private:
   void
@@ -0,0 +1,109 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-l3-rate-trace-helper.h"
+#include "tracers/ndn-l3-rate-tracer.h"
+
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include "ns3/ndn-forwarding-strategy.h"
+#include "ns3/binary-trace-writer.h"
+
+#include <boost/ref.hpp>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.L3RateTraceHelper");
+
+namespace ns3 {
+namespace ndn {
+
+L3RateTraceHelper::L3RateTraceHelper ()
+  : m_os (0)
+{
+}
+
+L3RateTraceHelper::~L3RateTraceHelper ()
+{
+  Reset ();
+}
+
+void
+L3RateTraceHelper::Reset ()
+{
+  m_tracers.clear ();
+
+  if (m_os != 0)
+    {
+      delete m_os;
+      m_os = 0;
+    }
+
+  if (m_writer != 0)
+    {
+      m_writer->Close ();
+      m_writer = 0;
+    }
+}
+
+void
+L3RateTraceHelper::EnableAll (const std::string &file, const Time &averagingPeriod)
+{
+  NS_LOG_FUNCTION (this << file << averagingPeriod);
+  Reset ();
+
+  m_os = new std::ofstream (file.c_str (), std::ios::trunc);
+  L3RateTracer::PrintHeader (*m_os);
+
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      if ((*node)->GetObject<ForwardingStrategy> () == 0)
+        continue;
+
+      Ptr<L3RateTracer> tracer = Create<L3RateTracer> (boost::ref (*m_os), *node);
+      tracer->SetAveragingPeriod (averagingPeriod);
+      m_tracers.push_back (tracer);
+    }
+}
+
+void
+L3RateTraceHelper::EnableBinaryAll (const std::string &file, const Time &averagingPeriod)
+{
+  NS_LOG_FUNCTION (this << file << averagingPeriod);
+  Reset ();
+
+  m_writer = Create<BinaryTraceWriter> (file);
+  L3RateTracer::SetupBinaryColumns (m_writer);
+
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      if ((*node)->GetObject<ForwardingStrategy> () == 0)
+        continue;
+
+      Ptr<L3RateTracer> tracer = Create<L3RateTracer> (m_writer, *node);
+      tracer->SetAveragingPeriod (averagingPeriod);
+      m_tracers.push_back (tracer);
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
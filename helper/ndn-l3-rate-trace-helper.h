@@ -0,0 +1,88 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_L3_RATE_TRACE_HELPER_H
+#define NDN_L3_RATE_TRACE_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+#include <string>
+#include <list>
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+class L3RateTracer;
+class BinaryTraceWriter;
+
+/**
+ * @brief Helper to trace per-face network-layer rates (Interests, NACKs, and Data) on all nodes
+ *
+ * Samples are printed every averaging period either as tab-separated text or into a binary
+ * columnar trace (see BinaryTraceWriter), which is written by a background thread and can
+ * be converted to CSV with the ndn-trace-to-csv tool.
+ *
+ * Usage:
+ *
+ *     ndn::L3RateTraceHelper rates;
+ *     rates.EnableBinaryAll ("l3-rate.bin", Seconds (0.5));
+ *     Simulator::Run ();
+ *     Simulator::Destroy ();
+ */
+class L3RateTraceHelper
+{
+public:
+  L3RateTraceHelper ();
+
+  /**
+   * @brief Stops tracing and flushes the output file
+   */
+  ~L3RateTraceHelper ();
+
+  /**
+   * @brief Enable text rate tracing on all nodes with NDN stack installed
+   * @param file name of the output file
+   * @param averagingPeriod period of printing and averaging
+   */
+  void
+  EnableAll (const std::string &file = "l3-rate.log", const Time &averagingPeriod = Seconds (1.0));
+
+  /**
+   * @brief Enable binary rate tracing on all nodes with NDN stack installed
+   * @param file name of the output file
+   * @param averagingPeriod period of printing and averaging
+   */
+  void
+  EnableBinaryAll (const std::string &file = "l3-rate.bin", const Time &averagingPeriod = Seconds (1.0));
+
+private:
+  void
+  Reset ();
+
+private:
+  std::list<Ptr<L3RateTracer> > m_tracers;
+  std::ostream *m_os;
+  Ptr<BinaryTraceWriter> m_writer;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_L3_RATE_TRACE_HELPER_H
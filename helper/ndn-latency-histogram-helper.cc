@@ -0,0 +1,154 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-latency-histogram-helper.h"
+
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "../apps/ndn-consumer.h"
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.LatencyHistogramHelper");
+
+namespace ns3 {
+namespace ndn {
+
+LatencyHistogramHelper::LatencyHistogramHelper ()
+  : m_os (0)
+{
+}
+
+LatencyHistogramHelper::~LatencyHistogramHelper ()
+{
+  m_dumpEvent.Cancel ();
+  if (m_os != 0)
+    delete m_os;
+}
+
+LatencyHistogram
+LatencyHistogramHelper::MergeAll (HistogramType type)
+{
+  LatencyHistogram merged;
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      for (uint32_t i = 0; i < (*node)->GetNApplications (); i++)
+        {
+          Ptr<Consumer> consumer = DynamicCast<Consumer> ((*node)->GetApplication (i));
+          if (consumer == 0)
+            continue;
+
+          merged += (type == RTT) ? consumer->GetRttHistogram () : consumer->GetDelayHistogram ();
+        }
+    }
+  return merged;
+}
+
+void
+LatencyHistogramHelper::PrintHeader (std::ostream &os)
+{
+  os << "Time" << "\t"
+     << "Node" << "\t"
+     << "AppId" << "\t"
+     << "Type" << "\t";
+  LatencyHistogram::PrintHeader (os);
+  os << "\n";
+}
+
+void
+LatencyHistogramHelper::PrintAll (std::ostream &os)
+{
+  double now = Simulator::Now ().ToDouble (Time::S);
+
+  LatencyHistogram rtt;
+  LatencyHistogram delay;
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      for (uint32_t i = 0; i < (*node)->GetNApplications (); i++)
+        {
+          Ptr<Consumer> consumer = DynamicCast<Consumer> ((*node)->GetApplication (i));
+          if (consumer == 0)
+            continue;
+
+          os << now << "\t" << (*node)->GetId () << "\t" << i << "\t" << "Rtt" << "\t";
+          consumer->GetRttHistogram ().Print (os);
+          os << "\n";
+
+          os << now << "\t" << (*node)->GetId () << "\t" << i << "\t" << "Delay" << "\t";
+          consumer->GetDelayHistogram ().Print (os);
+          os << "\n";
+
+          rtt += consumer->GetRttHistogram ();
+          delay += consumer->GetDelayHistogram ();
+        }
+    }
+
+  os << now << "\t" << "all" << "\t" << "all" << "\t" << "Rtt" << "\t";
+  rtt.Print (os);
+  os << "\n";
+
+  os << now << "\t" << "all" << "\t" << "all" << "\t" << "Delay" << "\t";
+  delay.Print (os);
+  os << "\n";
+}
+
+void
+LatencyHistogramHelper::EnablePeriodicDump (const std::string &file, const Time &period)
+{
+  NS_LOG_FUNCTION (this << file << period);
+
+  if (m_os != 0)
+    delete m_os;
+  m_os = new std::ofstream (file.c_str (), std::ios::trunc);
+  PrintHeader (*m_os);
+
+  m_period = period;
+  m_dumpEvent.Cancel ();
+  m_dumpEvent = Simulator::Schedule (m_period, &LatencyHistogramHelper::PeriodicDump, this);
+}
+
+void
+LatencyHistogramHelper::StopPeriodicDump ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_dumpEvent.Cancel ();
+  if (m_os == 0)
+    return;
+
+  PrintAll (*m_os);
+  delete m_os;
+  m_os = 0;
+}
+
+void
+LatencyHistogramHelper::PeriodicDump ()
+{
+  PrintAll (*m_os);
+  m_dumpEvent = Simulator::Schedule (m_period, &LatencyHistogramHelper::PeriodicDump, this);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,106 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_LATENCY_HISTOGRAM_HELPER_H
+#define NDN_LATENCY_HISTOGRAM_HELPER_H
+
+#include "ns3/latency-histogram.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <string>
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Helper to collect and dump latency histograms of all consumer applications
+ *
+ * Each ns3::ndn::Consumer maintains a fixed-memory histogram of RTTs (from the last
+ * Interest transmission) and delays (from the first transmission). The helper
+ * prints per-consumer percentiles and the histogram merged over all consumers,
+ * either on request or periodically
+ */
+class LatencyHistogramHelper
+{
+public:
+  enum HistogramType
+    {
+      RTT,  ///< RTT from the last transmission of the Interest
+      DELAY ///< delay from the first transmission of the Interest
+    };
+
+  LatencyHistogramHelper ();
+
+  /**
+   * @brief Stops periodic dumping and closes the output file
+   *
+   * No final dump is done here: the helper is usually destroyed after Simulator::Destroy,
+   * when NodeList is already empty.  Use StopPeriodicDump to get the final numbers
+   */
+  ~LatencyHistogramHelper ();
+
+  /**
+   * @brief Merge histograms of all consumer applications on all nodes
+   */
+  static LatencyHistogram
+  MergeAll (HistogramType type = RTT);
+
+  /**
+   * @brief Print per-consumer and merged histogram summaries
+   *
+   * Output is tab-separated: Time, Node, AppId, Type, followed by LatencyHistogram::Print fields.
+   * Merged histograms have "all" in Node and AppId columns
+   */
+  static void
+  PrintAll (std::ostream &os);
+
+  static void
+  PrintHeader (std::ostream &os);
+
+  /**
+   * @brief Periodically dump all histograms to the file
+   * @param file name of the output file
+   * @param period dump period
+   */
+  void
+  EnablePeriodicDump (const std::string &file = "latency.log", const Time &period = Seconds (1.0));
+
+  /**
+   * @brief Dump histograms one last time and stop periodic dumping
+   *
+   * Should be called after Simulator::Run () and before Simulator::Destroy ()
+   */
+  void
+  StopPeriodicDump ();
+
+private:
+  void
+  PeriodicDump ();
+
+private:
+  std::ostream *m_os;
+  Time m_period;
+  EventId m_dumpEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LATENCY_HISTOGRAM_HELPER_H
@@ -0,0 +1,221 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-memory-usage-helper.h"
+
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "ns3/ndn-pit.h"
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-content-store.h"
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.MemoryUsageHelper");
+
+namespace ns3 {
+namespace ndn {
+
+static const char *
+GetTableName (MemoryUsageHelper::Table table)
+{
+  switch (table)
+    {
+    case MemoryUsageHelper::PIT:
+      return "Pit";
+    case MemoryUsageHelper::FIB:
+      return "Fib";
+    case MemoryUsageHelper::CS:
+      return "Cs";
+    }
+  return "Unknown";
+}
+
+static uint32_t
+GetTableSize (Ptr<Node> node, MemoryUsageHelper::Table table)
+{
+  switch (table)
+    {
+    case MemoryUsageHelper::PIT:
+      {
+        Ptr<Pit> pit = node->GetObject<Pit> ();
+        return pit != 0 ? pit->GetSize () : 0;
+      }
+    case MemoryUsageHelper::FIB:
+      {
+        Ptr<Fib> fib = node->GetObject<Fib> ();
+        return fib != 0 ? fib->GetSize () : 0;
+      }
+    case MemoryUsageHelper::CS:
+      {
+        Ptr<ContentStore> cs = node->GetObject<ContentStore> ();
+        return cs != 0 ? cs->GetSize () : 0;
+      }
+    }
+  return 0;
+}
+
+MemoryUsageHelper::MemoryUsageHelper ()
+  : m_os (0)
+{
+}
+
+MemoryUsageHelper::~MemoryUsageHelper ()
+{
+  m_dumpEvent.Cancel ();
+  if (m_os != 0)
+    delete m_os;
+}
+
+MemoryUsage
+MemoryUsageHelper::GetNodeUsage (Ptr<Node> node, Table table)
+{
+  switch (table)
+    {
+    case PIT:
+      {
+        Ptr<Pit> pit = node->GetObject<Pit> ();
+        if (pit != 0)
+          return pit->GetMemoryUsage ();
+        break;
+      }
+    case FIB:
+      {
+        Ptr<Fib> fib = node->GetObject<Fib> ();
+        if (fib != 0)
+          return fib->GetMemoryUsage ();
+        break;
+      }
+    case CS:
+      {
+        Ptr<ContentStore> cs = node->GetObject<ContentStore> ();
+        if (cs != 0)
+          return cs->GetMemoryUsage ();
+        break;
+      }
+    }
+  return MemoryUsage ();
+}
+
+MemoryUsage
+MemoryUsageHelper::GetTotalUsage (Table table)
+{
+  MemoryUsage total;
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      total += GetNodeUsage (*node, table);
+    }
+  return total;
+}
+
+void
+MemoryUsageHelper::PrintHeader (std::ostream &os)
+{
+  os << "Time" << "\t"
+     << "Node" << "\t"
+     << "Table" << "\t"
+     << "Entries" << "\t"
+     << "Index" << "\t"
+     << "EntryBytes" << "\t"
+     << "Names" << "\t"
+     << "Total" << "\n";
+}
+
+void
+MemoryUsageHelper::PrintAll (std::ostream &os)
+{
+  double now = Simulator::Now ().ToDouble (Time::S);
+
+  for (int table = PIT; table <= CS; table++)
+    {
+      MemoryUsage total;
+      uint64_t totalEntries = 0;
+      for (NodeList::Iterator node = NodeList::Begin ();
+           node != NodeList::End ();
+           node++)
+        {
+          MemoryUsage usage = GetNodeUsage (*node, static_cast<Table> (table));
+          uint32_t entries = GetTableSize (*node, static_cast<Table> (table));
+
+          os << now << "\t"
+             << (*node)->GetId () << "\t"
+             << GetTableName (static_cast<Table> (table)) << "\t"
+             << entries << "\t"
+             << usage.m_index << "\t"
+             << usage.m_entries << "\t"
+             << usage.m_names << "\t"
+             << usage.GetTotal () << "\n";
+
+          total += usage;
+          totalEntries += entries;
+        }
+
+      os << now << "\t"
+         << "all" << "\t"
+         << GetTableName (static_cast<Table> (table)) << "\t"
+         << totalEntries << "\t"
+         << total.m_index << "\t"
+         << total.m_entries << "\t"
+         << total.m_names << "\t"
+         << total.GetTotal () << "\n";
+    }
+}
+
+void
+MemoryUsageHelper::EnablePeriodicDump (const std::string &file, const Time &period)
+{
+  NS_LOG_FUNCTION (this << file << period);
+
+  if (m_os != 0)
+    delete m_os;
+  m_os = new std::ofstream (file.c_str (), std::ios::trunc);
+  PrintHeader (*m_os);
+
+  m_period = period;
+  m_dumpEvent.Cancel ();
+  m_dumpEvent = Simulator::Schedule (m_period, &MemoryUsageHelper::PeriodicDump, this);
+}
+
+void
+MemoryUsageHelper::StopPeriodicDump ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_dumpEvent.Cancel ();
+  if (m_os == 0)
+    return;
+
+  PrintAll (*m_os);
+  delete m_os;
+  m_os = 0;
+}
+
+void
+MemoryUsageHelper::PeriodicDump ()
+{
+  PrintAll (*m_os);
+  m_dumpEvent = Simulator::Schedule (m_period, &MemoryUsageHelper::PeriodicDump, this);
+}
+
+} // namespace ndn
+} // namespace ns3
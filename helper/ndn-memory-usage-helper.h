@@ -0,0 +1,113 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_MEMORY_USAGE_HELPER_H
+#define NDN_MEMORY_USAGE_HELPER_H
+
+#include "ns3/memory-usage.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <string>
+#include <iostream>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @brief Helper to sample memory usage of PIT, FIB, and content store on nodes
+ *
+ * Numbers are estimates obtained from Pit::GetMemoryUsage, Fib::GetMemoryUsage,
+ * and ContentStore::GetMemoryUsage and can be queried per node, summed over all nodes,
+ * printed on request, or dumped periodically
+ */
+class MemoryUsageHelper
+{
+public:
+  enum Table
+    {
+      PIT,
+      FIB,
+      CS
+    };
+
+  MemoryUsageHelper ();
+
+  /**
+   * @brief Closes the output file without dumping (nodes are gone by then, see StopPeriodicDump)
+   */
+  ~MemoryUsageHelper ();
+
+  /**
+   * @brief Get memory usage of the table on the node (empty if the table is not installed)
+   */
+  static MemoryUsage
+  GetNodeUsage (Ptr<Node> node, Table table);
+
+  /**
+   * @brief Get memory usage of the table summed over all nodes
+   */
+  static MemoryUsage
+  GetTotalUsage (Table table);
+
+  /**
+   * @brief Print memory usage of every table on every node, followed by totals over all nodes
+   *
+   * Output is tab-separated: Time, Node, Table, Entries, Index, EntryBytes, Names, Total.
+   * Totals have "all" in Node column
+   */
+  static void
+  PrintAll (std::ostream &os);
+
+  static void
+  PrintHeader (std::ostream &os);
+
+  /**
+   * @brief Periodically dump memory usage to the file
+   * @param file name of the output file
+   * @param period dump period
+   */
+  void
+  EnablePeriodicDump (const std::string &file = "memory.log", const Time &period = Seconds (1.0));
+
+  /**
+   * @brief Dump memory usage one last time and stop periodic dumping
+   *
+   * Should be called after Simulator::Run () and before Simulator::Destroy ()
+   */
+  void
+  StopPeriodicDump ();
+
+private:
+  void
+  PeriodicDump ();
+
+private:
+  std::ostream *m_os;
+  Time m_period;
+  EventId m_dumpEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MEMORY_USAGE_HELPER_H
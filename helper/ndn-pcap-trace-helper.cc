@@ -0,0 +1,160 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-pcap-trace-helper.h"
+
+#include "ns3/ndn-l3-protocol.h"
+#include "ns3/ndn-face.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/log.h"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PcapTraceHelper");
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Trace sink that writes packets of one face into one of the writer's files
+ */
+class PcapTraceHelper::Sink : public SimpleRefCount<Sink>
+{
+public:
+  Sink (Ptr<PcapTraceWriter> writer, uint32_t file, Ptr<Face> face)
+    : m_writer (writer)
+    , m_file (file)
+    , m_face (face)
+  {
+  }
+
+  void
+  Trace (Ptr<const Packet> packet)
+  {
+    if (m_writer == 0)
+      return;
+
+    m_writer->Write (m_file, Simulator::Now (), packet);
+  }
+
+  void
+  Disconnect ()
+  {
+    m_face->TraceDisconnectWithoutContext ("NdnRx", MakeCallback (&Sink::Trace, this));
+    m_face->TraceDisconnectWithoutContext ("NdnTx", MakeCallback (&Sink::Trace, this));
+    m_writer = 0;
+  }
+
+private:
+  Ptr<PcapTraceWriter> m_writer;
+  uint32_t m_file;
+  Ptr<Face> m_face;
+};
+
+PcapTraceHelper::PcapTraceHelper (uint32_t snapLen, size_t blockSize)
+  : m_writer (Create<PcapTraceWriter> (snapLen, 9 /* DLT_PPP */, blockSize))
+{
+}
+
+PcapTraceHelper::~PcapTraceHelper ()
+{
+  Close ();
+}
+
+void
+PcapTraceHelper::EnableMerged (const std::string &file, const NodeContainer &nodes, Direction direction)
+{
+  uint32_t fileId = m_writer->AddFile (file);
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      Ptr<L3Protocol> ndn = (*node)->GetObject<L3Protocol> ();
+      NS_ASSERT_MSG (ndn != 0, "Ndn stack should be installed on node " << (*node)->GetId ());
+
+      for (uint32_t faceId = 0; faceId < ndn->GetNFaces (); faceId++)
+        {
+          Connect (ndn->GetFace (faceId), fileId, direction);
+        }
+    }
+}
+
+void
+PcapTraceHelper::EnablePerFace (const std::string &prefix, const NodeContainer &nodes, Direction direction)
+{
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      Ptr<L3Protocol> ndn = (*node)->GetObject<L3Protocol> ();
+      NS_ASSERT_MSG (ndn != 0, "Ndn stack should be installed on node " << (*node)->GetId ());
+
+      for (uint32_t faceId = 0; faceId < ndn->GetNFaces (); faceId++)
+        {
+          Ptr<Face> face = ndn->GetFace (faceId);
+          if (face == 0)
+            continue;
+
+          std::string file = prefix + "-" +
+            boost::lexical_cast<std::string> ((*node)->GetId ()) + "-" +
+            boost::lexical_cast<std::string> (face->GetId ()) + ".pcap";
+          Connect (face, m_writer->AddFile (file), direction);
+        }
+    }
+}
+
+void
+PcapTraceHelper::EnableFace (const std::string &file, Ptr<Face> face, Direction direction)
+{
+  Connect (face, m_writer->AddFile (file), direction);
+}
+
+void
+PcapTraceHelper::Close ()
+{
+  for (std::list< Ptr<Sink> >::iterator sink = m_sinks.begin (); sink != m_sinks.end (); sink++)
+    {
+      (*sink)->Disconnect ();
+    }
+  m_sinks.clear ();
+
+  m_writer->Close ();
+}
+
+Ptr<PcapTraceWriter>
+PcapTraceHelper::GetWriter () const
+{
+  return m_writer;
+}
+
+void
+PcapTraceHelper::Connect (Ptr<Face> face, uint32_t file, Direction direction)
+{
+  if (face == 0)
+    return;
+
+  Ptr<Sink> sink = Create<Sink> (m_writer, file, face);
+  if (direction & RX)
+    face->TraceConnectWithoutContext ("NdnRx", MakeCallback (&Sink::Trace, PeekPointer (sink)));
+  if (direction & TX)
+    face->TraceConnectWithoutContext ("NdnTx", MakeCallback (&Sink::Trace, PeekPointer (sink)));
+
+  m_sinks.push_back (sink);
+}
+
+} // namespace ndn
+} // namespace ns3
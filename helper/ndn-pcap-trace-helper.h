@@ -0,0 +1,121 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_PCAP_TRACE_HELPER_H
+#define NDN_PCAP_TRACE_HELPER_H
+
+#include "ns3/pcap-trace-writer.h"
+#include "ns3/ptr.h"
+#include "ns3/node-container.h"
+
+#include <string>
+#include <list>
+
+namespace ns3 {
+
+class Packet;
+
+namespace ndn {
+
+class Face;
+
+/**
+ * @brief Helper to capture packets received and/or transmitted by NDN faces to pcap files
+ *
+ * Faces' NdnRx and NdnTx traces are connected to a PcapTraceWriter, which buffers
+ * records in large blocks and writes them on a background thread.  Packets of
+ * all selected faces can be captured into one (merged) file, or each face can
+ * have its own file.  Only faces that exist when Enable* is called are captured
+ * (e.g., faces of applications are created when the applications start).
+ *
+ * Usage:
+ *
+ *     ndn::PcapTraceHelper pcap (128); // save at most 128 bytes of each packet
+ *     pcap.EnableMerged ("consumers.pcap", consumerNodes);
+ *     pcap.EnablePerFace ("router", routerNodes, ndn::PcapTraceHelper::BOTH);
+ *     ...
+ *     Simulator::Run ();
+ *     pcap.Close (); // or when the helper is destroyed
+ */
+class PcapTraceHelper
+{
+public:
+  enum Direction
+    {
+      RX = 1,   ///< @brief packets received by the face (NdnRx)
+      TX = 2,   ///< @brief packets transmitted by the face (NdnTx)
+      BOTH = 3
+    };
+
+  /**
+   * @brief Create helper
+   * @param snapLen maximum number of bytes of each packet saved in the file
+   * @param blockSize size of the buffer block of each file
+   */
+  PcapTraceHelper (uint32_t snapLen = 65535, size_t blockSize = 1024 * 1024);
+
+  /**
+   * @brief Writes all pending records and closes files
+   */
+  ~PcapTraceHelper ();
+
+  /**
+   * @brief Capture packets of all faces of `nodes' into one file
+   */
+  void
+  EnableMerged (const std::string &file, const NodeContainer &nodes, Direction direction = RX);
+
+  /**
+   * @brief Capture packets of each face of `nodes' into a separate file <prefix>-<node>-<face>.pcap
+   */
+  void
+  EnablePerFace (const std::string &prefix, const NodeContainer &nodes, Direction direction = RX);
+
+  /**
+   * @brief Capture packets of the face into the file
+   */
+  void
+  EnableFace (const std::string &file, Ptr<Face> face, Direction direction = RX);
+
+  /**
+   * @brief Write all pending records and close files (no packets are captured afterwards)
+   */
+  void
+  Close ();
+
+  /**
+   * @brief Get writer used by the helper
+   */
+  Ptr<PcapTraceWriter>
+  GetWriter () const;
+
+private:
+  class Sink;
+
+  void
+  Connect (Ptr<Face> face, uint32_t file, Direction direction);
+
+private:
+  Ptr<PcapTraceWriter> m_writer;
+  std::list< Ptr<Sink> > m_sinks;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PCAP_TRACE_HELPER_H
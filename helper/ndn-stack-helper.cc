@@ -36,6 +36,7 @@
 
 #include "../model/ndn-net-device-face.h"
 #include "../model/ndn-l3-protocol.h"
+#include "../model/fw/strategy-choice.h"
 
 #include "ns3/ndn-forwarding-strategy.h"
 #include "ns3/ndn-fib.h"
@@ -330,5 +331,16 @@ StackHelper::AddRoute (std::string nodeName, std::string prefix, uint32_t faceId
   AddRoute (node, prefix, face, metric);
 }
 
+Ptr<ForwardingStrategy>
+StackHelper::SetPrefixStrategy (Ptr<Node> node, const std::string &prefix, const std::string &strategy)
+{
+  NS_LOG_LOGIC ("[" << node->GetId () << "]$ strategy set " << prefix << " " << strategy);
+
+  Ptr<fw::StrategyChoice> strategyChoice = node->GetObject<fw::StrategyChoice> ();
+  NS_ASSERT_MSG (strategyChoice != 0, "ns3::ndn::fw::StrategyChoice should be installed on node [" << node->GetId () << "]");
+
+  return strategyChoice->SetStrategy (prefix, strategy);
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -35,6 +35,7 @@ namespace ndn {
 
 class FaceContainer;
 class Face;
+class ForwardingStrategy;
 
 /**
  * \ingroup ndn
@@ -224,6 +225,19 @@ public:
   static void
   AddRoute (Ptr<Node> node, std::string prefix, Ptr<Face> face, int32_t metric);
 
+  /**
+   * \brief Use forwarding strategy `strategy' for Interests under `prefix' on the node
+   *
+   * The node should be using ns3::ndn::fw::StrategyChoice forwarding strategy (see SetForwardingStrategy)
+   *
+   * \param node     Node
+   * \param prefix   Name prefix
+   * \param strategy Strategy TypeId name, e.g., "ns3::ndn::fw::BestRoute"
+   * \returns created strategy object (to allow further configuration)
+   */
+  static Ptr<ForwardingStrategy>
+  SetPrefixStrategy (Ptr<Node> node, const std::string &prefix, const std::string &strategy);
+
   /**
    * \brief Set flag indicating necessity to install default routes in FIB
    */
@@ -0,0 +1,317 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-l3-rate-tracer.h"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/packet.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-interest-header.h"
+#include "ns3/ndn-content-object-header.h"
+#include "ns3/ndn-forwarding-strategy.h"
+#include "ns3/binary-trace-writer.h"
+
+#include <boost/lexical_cast.hpp>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+static const char *TYPE_NAMES [] = {
+  "InInterests", "OutInterests", "DropInterests",
+  "InNacks",     "OutNacks",     "DropNacks",
+  "InData",      "OutData",      "DropData"
+};
+
+// weight of the last period in the averaged rates
+static const double alpha = 0.8;
+
+L3RateTracer::Stats::Stats ()
+  : m_hasFaceDescr (false)
+  , m_faceDescr (0)
+{
+  for (int type = 0; type < TYPE_COUNT; type++)
+    {
+      m_packets [type] = 0;
+      m_bytes [type] = 0;
+      m_packetRate [type] = 0;
+      m_kilobyteRate [type] = 0;
+    }
+}
+
+L3RateTracer::L3RateTracer (std::ostream &os, Ptr<Node> node)
+  : m_os (&os)
+  , m_nodeId (0)
+{
+  Connect (node);
+  SetAveragingPeriod (Seconds (1.0));
+}
+
+L3RateTracer::L3RateTracer (Ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : m_os (0)
+  , m_writer (writer)
+{
+  Connect (node);
+
+  m_nodeId = m_writer->Intern (m_node);
+  for (int type = 0; type < TYPE_COUNT; type++)
+    m_typeIds [type] = m_writer->Intern (TYPE_NAMES [type]);
+
+  SetAveragingPeriod (Seconds (1.0));
+}
+
+L3RateTracer::~L3RateTracer ()
+{
+  m_printEvent.Cancel ();
+  Disconnect ();
+}
+
+void
+L3RateTracer::Connect (Ptr<Node> node)
+{
+  m_node = Names::FindName (node);
+  if (m_node.empty ())
+    m_node = boost::lexical_cast<std::string> (node->GetId ());
+
+  m_fw = node->GetObject<ForwardingStrategy> ();
+  NS_ASSERT_MSG (m_fw != 0, "NDN stack should be installed on node " << m_node);
+
+  m_fw->TraceConnectWithoutContext ("OutInterests",  MakeCallback (&L3RateTracer::OutInterests, this));
+  m_fw->TraceConnectWithoutContext ("InInterests",   MakeCallback (&L3RateTracer::InInterests, this));
+  m_fw->TraceConnectWithoutContext ("DropInterests", MakeCallback (&L3RateTracer::DropInterests, this));
+
+  // only strategies derived from fw::Nacks have these
+  m_fw->TraceConnectWithoutContext ("OutNacks",  MakeCallback (&L3RateTracer::OutNacks, this));
+  m_fw->TraceConnectWithoutContext ("InNacks",   MakeCallback (&L3RateTracer::InNacks, this));
+  m_fw->TraceConnectWithoutContext ("DropNacks", MakeCallback (&L3RateTracer::DropNacks, this));
+
+  m_fw->TraceConnectWithoutContext ("OutData",  MakeCallback (&L3RateTracer::OutData, this));
+  m_fw->TraceConnectWithoutContext ("InData",   MakeCallback (&L3RateTracer::InData, this));
+  m_fw->TraceConnectWithoutContext ("DropData", MakeCallback (&L3RateTracer::DropData, this));
+}
+
+void
+L3RateTracer::Disconnect ()
+{
+  // the strategy outlives the tracer (e.g., after L3RateTraceHelper::Reset), so sinks should not be left behind
+  if (m_fw == 0)
+    return;
+
+  m_fw->TraceDisconnectWithoutContext ("OutInterests",  MakeCallback (&L3RateTracer::OutInterests, this));
+  m_fw->TraceDisconnectWithoutContext ("InInterests",   MakeCallback (&L3RateTracer::InInterests, this));
+  m_fw->TraceDisconnectWithoutContext ("DropInterests", MakeCallback (&L3RateTracer::DropInterests, this));
+
+  m_fw->TraceDisconnectWithoutContext ("OutNacks",  MakeCallback (&L3RateTracer::OutNacks, this));
+  m_fw->TraceDisconnectWithoutContext ("InNacks",   MakeCallback (&L3RateTracer::InNacks, this));
+  m_fw->TraceDisconnectWithoutContext ("DropNacks", MakeCallback (&L3RateTracer::DropNacks, this));
+
+  m_fw->TraceDisconnectWithoutContext ("OutData",  MakeCallback (&L3RateTracer::OutData, this));
+  m_fw->TraceDisconnectWithoutContext ("InData",   MakeCallback (&L3RateTracer::InData, this));
+  m_fw->TraceDisconnectWithoutContext ("DropData", MakeCallback (&L3RateTracer::DropData, this));
+
+  m_fw = 0;
+}
+
+void
+L3RateTracer::SetupBinaryColumns (Ptr<BinaryTraceWriter> writer)
+{
+  writer->AddColumn ("Time",      BinaryTraceFormat::COLUMN_DOUBLE);
+  writer->AddColumn ("Node",      BinaryTraceFormat::COLUMN_STRING);
+  writer->AddColumn ("FaceId",    BinaryTraceFormat::COLUMN_UINT64);
+  writer->AddColumn ("FaceDescr", BinaryTraceFormat::COLUMN_STRING);
+  writer->AddColumn ("Type",      BinaryTraceFormat::COLUMN_STRING);
+  writer->AddColumn ("Packets",   BinaryTraceFormat::COLUMN_DOUBLE);
+  writer->AddColumn ("Kilobytes", BinaryTraceFormat::COLUMN_DOUBLE);
+}
+
+void
+L3RateTracer::SetAveragingPeriod (const Time &period)
+{
+  m_period = period;
+  m_printEvent.Cancel ();
+  m_printEvent = Simulator::Schedule (m_period, &L3RateTracer::PeriodicPrinter, this);
+}
+
+void
+L3RateTracer::PeriodicPrinter ()
+{
+  double seconds = m_period.ToDouble (Time::S);
+  for (std::map<Ptr<const Face>, Stats>::iterator stats = m_stats.begin ();
+       stats != m_stats.end ();
+       stats++)
+    {
+      for (int type = 0; type < TYPE_COUNT; type++)
+        {
+          stats->second.m_packetRate [type] =
+            alpha * stats->second.m_packets [type] / seconds + (1 - alpha) * stats->second.m_packetRate [type];
+          stats->second.m_kilobyteRate [type] =
+            alpha * stats->second.m_bytes [type] / seconds / 1024.0 + (1 - alpha) * stats->second.m_kilobyteRate [type];
+
+          stats->second.m_packets [type] = 0;
+          stats->second.m_bytes [type] = 0;
+        }
+    }
+
+  if (m_writer != 0)
+    PrintBinary ();
+  else
+    Print (*m_os);
+
+  m_printEvent = Simulator::Schedule (m_period, &L3RateTracer::PeriodicPrinter, this);
+}
+
+void
+L3RateTracer::PrintHeader (std::ostream &os)
+{
+  os << "Time" << "\t"
+
+     << "Node" << "\t"
+     << "FaceId" << "\t"
+     << "FaceDescr" << "\t"
+
+     << "Type" << "\t"
+     << "Packets" << "\t"
+     << "Kilobytes" << "\n";
+}
+
+void
+L3RateTracer::Print (std::ostream &os) const
+{
+  double now = Simulator::Now ().ToDouble (Time::S);
+  for (std::map<Ptr<const Face>, Stats>::const_iterator stats = m_stats.begin ();
+       stats != m_stats.end ();
+       stats++)
+    {
+      for (int type = 0; type < TYPE_COUNT; type++)
+        {
+          os << now << "\t"
+             << m_node << "\t"
+             << stats->first->GetId () << "\t"
+             << *stats->first << "\t"
+             << TYPE_NAMES [type] << "\t"
+             << stats->second.m_packetRate [type] << "\t"
+             << stats->second.m_kilobyteRate [type] << "\n";
+        }
+    }
+}
+
+void
+L3RateTracer::PrintBinary ()
+{
+  BinaryTraceWriter::Record record;
+  record.SetDouble (0, Simulator::Now ().ToDouble (Time::S));
+  record.SetString (1, m_nodeId);
+
+  for (std::map<Ptr<const Face>, Stats>::iterator stats = m_stats.begin ();
+       stats != m_stats.end ();
+       stats++)
+    {
+      // face description is formatted only once per face
+      if (!stats->second.m_hasFaceDescr)
+        {
+          std::ostringstream descr;
+          descr << *stats->first;
+          stats->second.m_faceDescr = m_writer->Intern (descr.str ());
+          stats->second.m_hasFaceDescr = true;
+        }
+
+      record.SetUint   (2, stats->first->GetId ());
+      record.SetString (3, stats->second.m_faceDescr);
+
+      for (int type = 0; type < TYPE_COUNT; type++)
+        {
+          record.SetString (4, m_typeIds [type]);
+          record.SetDouble (5, stats->second.m_packetRate [type]);
+          record.SetDouble (6, stats->second.m_kilobyteRate [type]);
+          m_writer->Write (record);
+        }
+    }
+}
+
+void
+L3RateTracer::Count (Ptr<const Face> face, Type type, uint32_t bytes)
+{
+  Stats &stats = m_stats [face];
+  stats.m_packets [type] ++;
+  stats.m_bytes [type] += bytes;
+}
+
+void
+L3RateTracer::OutInterests (Ptr<const InterestHeader> header, Ptr<const Face> face)
+{
+  Count (face, OUT_INTERESTS, header->GetSerializedSize ());
+}
+
+void
+L3RateTracer::OutNacks (Ptr<const InterestHeader> header, Ptr<const Face> face)
+{
+  Count (face, OUT_NACKS, header->GetSerializedSize ());
+}
+
+void
+L3RateTracer::InInterests (Ptr<const InterestHeader> header, Ptr<const Face> face)
+{
+  Count (face, IN_INTERESTS, header->GetSerializedSize ());
+}
+
+void
+L3RateTracer::InNacks (Ptr<const InterestHeader> header, Ptr<const Face> face)
+{
+  Count (face, IN_NACKS, header->GetSerializedSize ());
+}
+
+void
+L3RateTracer::DropInterests (Ptr<const InterestHeader> header, Ptr<const Face> face)
+{
+  Count (face, DROP_INTERESTS, header->GetSerializedSize ());
+}
+
+void
+L3RateTracer::DropNacks (Ptr<const InterestHeader> header, Ptr<const Face> face)
+{
+  Count (face, DROP_NACKS, header->GetSerializedSize ());
+}
+
+void
+L3RateTracer::OutData (Ptr<const ContentObjectHeader> header, Ptr<const Packet> payload,
+                       bool fromCache, Ptr<const Face> face)
+{
+  Count (face, OUT_DATA, header->GetSerializedSize () + payload->GetSize ());
+}
+
+void
+L3RateTracer::InData (Ptr<const ContentObjectHeader> header, Ptr<const Packet> payload,
+                      Ptr<const Face> face)
+{
+  Count (face, IN_DATA, header->GetSerializedSize () + payload->GetSize ());
+}
+
+void
+L3RateTracer::DropData (Ptr<const ContentObjectHeader> header, Ptr<const Packet> payload,
+                        Ptr<const Face> face)
+{
+  Count (face, DROP_DATA, header->GetSerializedSize () + payload->GetSize ());
+}
+
+} // namespace ndn
+} // namespace ns3
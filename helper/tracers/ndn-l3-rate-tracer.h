@@ -0,0 +1,169 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_L3_RATE_TRACER_H
+#define NDN_L3_RATE_TRACER_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <string>
+#include <map>
+#include <iostream>
+
+namespace ns3 {
+
+class Node;
+class Packet;
+
+namespace ndn {
+
+class Face;
+class InterestHeader;
+class ContentObjectHeader;
+class BinaryTraceWriter;
+class ForwardingStrategy;
+
+/**
+ * @ingroup ndn
+ * @brief Network-layer rate tracer
+ *
+ * Counts Interests, NACKs, and Data on each face of the node (using ForwardingStrategy
+ * traces; NACKs are counted only if the strategy provides NACK traces, see fw::Nacks) and periodically prints exponentially averaged packet and kilobyte rates,
+ * either as text or into a BinaryTraceWriter.  In binary mode, node name, face
+ * descriptions, and sample types are interned once, so nothing is formatted per sample
+ */
+class L3RateTracer : public SimpleRefCount<L3RateTracer>
+{
+public:
+  /**
+   * @brief Create tracer printing text samples to the stream
+   */
+  L3RateTracer (std::ostream &os, Ptr<Node> node);
+
+  /**
+   * @brief Create tracer writing samples to the binary trace
+   *
+   * @see SetupBinaryColumns
+   */
+  L3RateTracer (Ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
+  ~L3RateTracer ();
+
+  /**
+   * @brief Add columns to the binary trace writer (should be called once per writer)
+   */
+  static void
+  SetupBinaryColumns (Ptr<BinaryTraceWriter> writer);
+
+  static void
+  PrintHeader (std::ostream &os);
+
+  /**
+   * @brief Print rates calculated at the end of the last averaging period
+   */
+  void
+  Print (std::ostream &os) const;
+
+  void
+  SetAveragingPeriod (const Time &period);
+
+private:
+  void
+  Connect (Ptr<Node> node);
+
+  void
+  Disconnect ();
+
+  void
+  OutInterests (Ptr<const InterestHeader>, Ptr<const Face>);
+
+  void
+  InInterests (Ptr<const InterestHeader>, Ptr<const Face>);
+
+  void
+  DropInterests (Ptr<const InterestHeader>, Ptr<const Face>);
+
+  void
+  OutNacks (Ptr<const InterestHeader>, Ptr<const Face>);
+
+  void
+  InNacks (Ptr<const InterestHeader>, Ptr<const Face>);
+
+  void
+  DropNacks (Ptr<const InterestHeader>, Ptr<const Face>);
+
+  void
+  OutData (Ptr<const ContentObjectHeader>, Ptr<const Packet>, bool fromCache, Ptr<const Face>);
+
+  void
+  InData (Ptr<const ContentObjectHeader>, Ptr<const Packet>, Ptr<const Face>);
+
+  void
+  DropData (Ptr<const ContentObjectHeader>, Ptr<const Packet>, Ptr<const Face>);
+
+  void
+  PeriodicPrinter ();
+
+  void
+  PrintBinary ();
+
+  enum Type
+    {
+      IN_INTERESTS, OUT_INTERESTS, DROP_INTERESTS,
+      IN_NACKS,     OUT_NACKS,     DROP_NACKS,
+      IN_DATA,      OUT_DATA,      DROP_DATA,
+      TYPE_COUNT
+    };
+
+  struct Stats
+  {
+    Stats ();
+
+    double m_packets [TYPE_COUNT];      ///< \brief packets in the current period
+    double m_bytes [TYPE_COUNT];        ///< \brief bytes in the current period
+    double m_packetRate [TYPE_COUNT];   ///< \brief averaged packets per second
+    double m_kilobyteRate [TYPE_COUNT]; ///< \brief averaged kilobytes per second
+
+    bool     m_hasFaceDescr;
+    uint32_t m_faceDescr; ///< \brief ID of face description in the binary trace dictionary
+  };
+
+  void
+  Count (Ptr<const Face> face, Type type, uint32_t bytes);
+
+private:
+  Ptr<ForwardingStrategy> m_fw; ///< \brief Strategy, traces of which the tracer is connected to
+  std::string m_node;
+  std::ostream *m_os;
+  Ptr<BinaryTraceWriter> m_writer;
+  uint32_t m_nodeId;                ///< \brief ID of node name in the binary trace dictionary
+  uint32_t m_typeIds [TYPE_COUNT];  ///< \brief IDs of sample types in the binary trace dictionary
+
+  Time m_period;
+  EventId m_printEvent;
+
+  std::map<Ptr<const Face>, Stats> m_stats;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_L3_RATE_TRACER_H
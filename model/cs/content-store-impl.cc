@@ -26,6 +26,9 @@
 #include "../../utils/random-policy.h"
 #include "../../utils/lru-policy.h"
 #include "../../utils/fifo-policy.h"
+#include "../../utils/arc-policy.h"
+#include "../../utils/slru-policy.h"
+#include "../../utils/tinylfu-policy.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.cs.ContentStoreImpl");
 
@@ -103,6 +106,63 @@ ContentStoreImpl< fifo_policy_traits >::GetTypeId ()
   return tid;
 }
 
+template<>
+TypeId
+ContentStoreImpl< arc_policy_traits >::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::cs::Arc")
+    .SetGroupName ("Ndn")
+    .SetParent<ContentStore> ()
+    .AddConstructor< ContentStoreImpl< arc_policy_traits > > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&ContentStoreImpl< arc_policy_traits >::GetMaxSize,
+                                         &ContentStoreImpl< arc_policy_traits >::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+
+  return tid;
+}
+
+template<>
+TypeId
+ContentStoreImpl< slru_policy_traits >::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::cs::Slru")
+    .SetGroupName ("Ndn")
+    .SetParent<ContentStore> ()
+    .AddConstructor< ContentStoreImpl< slru_policy_traits > > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&ContentStoreImpl< slru_policy_traits >::GetMaxSize,
+                                         &ContentStoreImpl< slru_policy_traits >::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+
+  return tid;
+}
+
+template<>
+TypeId
+ContentStoreImpl< tinylfu_policy_traits >::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::cs::TinyLfu")
+    .SetGroupName ("Ndn")
+    .SetParent<ContentStore> ()
+    .AddConstructor< ContentStoreImpl< tinylfu_policy_traits > > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&ContentStoreImpl< tinylfu_policy_traits >::GetMaxSize,
+                                         &ContentStoreImpl< tinylfu_policy_traits >::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+
+  return tid;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -163,11 +223,13 @@ template<class Policy>
 void 
 ContentStoreImpl<Policy>::Print (std::ostream &os) const
 {
-  for (typename super::policy_container::const_iterator item = this->getPolicy ().begin ();
-       item != this->getPolicy ().end ();
-       item++)
-  // BOOST_FOREACH (const typename super::parent_trie &item, this->getPolicy ())
+  // policies may keep entries in several containers (e.g., segments of ARC and SLRU),
+  // so walk the trie instead. !!! unordered_set imposes "random" order of item in the same level !!!
+  typename super::parent_trie::const_recursive_iterator item (this->getTrie ()), end (0);
+  for (; item != end; item++)
     {
+      if (item->payload () == 0) continue;
+
       os << item->payload ()->GetName () << std::endl;
     }
 }
@@ -193,6 +255,24 @@ ContentStoreImpl<Policy>::GetSize () const
   return this->getPolicy ().size ();
 }
 
+template<class Policy>
+MemoryUsage
+ContentStoreImpl<Policy>::GetMemoryUsage () const
+{
+  MemoryUsage usage;
+  usage.m_index += super::getTrie ().memory_usage ();
+
+  typename super::parent_trie::const_recursive_iterator item (super::getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      usage.m_entries += sizeof (entry);
+      usage += item->payload ()->GetMemoryUsage ();
+    }
+  return usage;
+}
+
 template<class Policy>
 Ptr<Entry>
 ContentStoreImpl<Policy>::Begin ()
@@ -247,10 +327,16 @@ ContentStoreImpl<Policy>::Next (Ptr<Entry> from)
 template class ContentStoreImpl<lru_policy_traits>;
 template class ContentStoreImpl<random_policy_traits>;
 template class ContentStoreImpl<fifo_policy_traits>;
+template class ContentStoreImpl<arc_policy_traits>;
+template class ContentStoreImpl<slru_policy_traits>;
+template class ContentStoreImpl<tinylfu_policy_traits>;
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, slru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, tinylfu_policy_traits);
 
 
 } // namespace cs
@@ -94,6 +94,9 @@ public:
   virtual uint32_t
   GetSize () const;
 
+  virtual MemoryUsage
+  GetMemoryUsage () const;
+
   virtual Ptr<Entry>
   Begin ();
 
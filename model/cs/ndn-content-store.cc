@@ -77,6 +77,17 @@ Entry::GetFullyFormedNdnPacket () const
   return packet;
 }
 
+MemoryUsage
+Entry::GetMemoryUsage () const
+{
+  MemoryUsage usage;
+  usage.m_entries += sizeof (ContentObjectHeader) + sizeof (Packet) + m_packet->GetSize ();
+  usage.m_names += sizeof (NameComponents) + DynamicSize (m_header->GetName ().GetComponents ());
+  if (m_header->GetLocatorPtr () != 0)
+    usage.m_names += sizeof (NameComponents) + DynamicSize (m_header->GetLocatorPtr ()->GetComponents ());
+  return usage;
+}
+
 const NameComponents&
 Entry::GetName () const
 {
@@ -25,6 +25,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/traced-callback.h"
+#include "ns3/memory-usage.h"
 
 #include <boost/tuple/tuple.hpp>
 
@@ -93,6 +94,14 @@ public:
   Ptr<Packet>
   GetFullyFormedNdnPacket () const;
 
+  /**
+   * \brief Get memory used by the stored header and content
+   *
+   * Size of the entry object itself is not included, it is accounted by the content store implementation
+   */
+  MemoryUsage
+  GetMemoryUsage () const;
+
 private:
   Ptr<const ContentObjectHeader> m_header; ///< \brief non-modifiable ContentObjectHeader
   Ptr<Packet> m_packet; ///< \brief non-modifiable content of the ContentObject packet
@@ -169,6 +178,12 @@ public:
   virtual uint32_t
   GetSize () const = 0;
 
+  /**
+   * @brief Get estimate of memory used by the content store (index, entries, and names)
+   */
+  virtual MemoryUsage
+  GetMemoryUsage () const = 0;
+
   /**
    * @brief Return first element of content store (no order guaranteed)
    */
@@ -145,6 +145,25 @@ Entry::Invalidate ()
     }
 }
 
+void
+Entry::InvalidateFace (Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (this << boost::cref(*face));
+
+  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
+  if (record == m_faces.get<i_face> ().end ())
+    return;
+
+  m_faces.modify (record,
+                  (&ll::_1)->*&FaceMetric::m_routingCost = std::numeric_limits<uint16_t>::max ());
+
+  m_faces.modify (record,
+                  (&ll::_1)->*&FaceMetric::m_status = FaceMetric::NDN_FIB_RED);
+
+  // reordering random access index same way as by metric index
+  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+}
+
 const FaceMetric &
 Entry::FindBestCandidate (uint32_t skip/* = 0*/) const
 {
@@ -153,6 +172,18 @@ Entry::FindBestCandidate (uint32_t skip/* = 0*/) const
   return m_faces.get<i_nth> () [skip];
 }
 
+MemoryUsage
+Entry::GetMemoryUsage () const
+{
+  MemoryUsage usage;
+  // each node carries two ordered index headers (3 words each) and one random access
+  // back-pointer, plus one pointer per reserved slot of the random access index
+  usage.m_entries += m_faces.size () * (sizeof (FaceMetric) + 7 * sizeof (void*))
+    + m_faces.get<i_nth> ().capacity () * sizeof (void*);
+  usage.m_names += sizeof (NameComponents) + DynamicSize (m_prefix->GetComponents ());
+  return usage;
+}
+
 std::ostream& operator<< (std::ostream& os, const Entry &entry)
 {
   for (FaceMetricContainer::type::index<i_nth>::type::iterator metric =
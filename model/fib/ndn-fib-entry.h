@@ -25,6 +25,7 @@
 #include "ns3/nstime.h"
 #include "ns3/ndn-face.h"
 #include "ns3/ndn-name-components.h"
+#include "ns3/memory-usage.h"
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -199,6 +200,15 @@ public:
   void
   Invalidate ();
 
+  /**
+   * @brief Invalidate a single face of the entry
+   *
+   * Set routing metric on the face to max and status to RED.  Does nothing if face is not
+   * part of the entry
+   */
+  void
+  InvalidateFace (Ptr<Face> face);
+
   /**
    * @brief Update RTT averages for the face
    */
@@ -227,6 +237,14 @@ public:
   {
     m_faces.erase (face);
   }
+
+  /**
+   * @brief Get memory used by the face container and by the prefix of the entry
+   *
+   * Size of the entry object itself is not included, it is accounted by the FIB implementation
+   */
+  MemoryUsage
+  GetMemoryUsage () const;
 	
 private:
   friend std::ostream& operator<< (std::ostream& os, const Entry &entry);
@@ -149,6 +149,22 @@ FibImpl::Remove (const Ptr<const NameComponents> &prefix)
 //                  ll::bind (&Entry::Invalidate, ll::_1));
 // }
 
+void
+FibImpl::Invalidate (const Ptr<const NameComponents> &prefix, Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix) << boost::cref(*face));
+
+  super::iterator foundItem, lastItem;
+  bool reachLast;
+  boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (*prefix);
+
+  if (!reachLast || lastItem->payload () == 0)
+    return; // nothing to invalidate
+
+  super::modify (lastItem,
+                 ll::bind (&Entry::InvalidateFace, ll::_1, face));
+}
+
 void
 FibImpl::InvalidateAll ()
 {
@@ -218,6 +234,23 @@ FibImpl::GetSize () const
   return super::getPolicy ().size ();
 }
 
+MemoryUsage
+FibImpl::GetMemoryUsage () const
+{
+  MemoryUsage usage;
+  usage.m_index += super::getTrie ().memory_usage ();
+
+  super::parent_trie::const_recursive_iterator item (super::getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      usage.m_entries += sizeof (EntryImpl);
+      usage += item->payload ()->GetMemoryUsage ();
+    }
+  return usage;
+}
+
 Ptr<const Entry>
 FibImpl::Begin ()
 {
@@ -100,6 +100,9 @@ public:
   virtual void
   Remove (const Ptr<const NameComponents> &prefix);
 
+  virtual void
+  Invalidate (const Ptr<const NameComponents> &prefix, Ptr<Face> face);
+
   virtual void
   InvalidateAll ();
   
@@ -112,6 +115,9 @@ public:
   virtual uint32_t
   GetSize () const;
 
+  virtual MemoryUsage
+  GetMemoryUsage () const;
+
   virtual Ptr<const Entry>
   Begin ();
 
@@ -116,6 +116,18 @@ public:
   // virtual void
   // Invalidate (const Ptr<const NameComponents> &prefix) = 0;
 
+  /**
+   * @brief Invalidate `face' in the FIB entry for exactly `prefix' ("Safe" version of Remove)
+   *
+   * The face will be assigned maximum routing metric and NDN_FIB_RED status.  Nothing is done
+   * if there is no entry for the prefix or the entry does not contain the face
+   *
+   * @param name	Smart pointer to prefix
+   * @param face	Forwarding face
+   */
+  virtual void
+  Invalidate (const Ptr<const NameComponents> &prefix, Ptr<Face> face) = 0;
+
   /**
    * @brief Invalidate all FIB entries
    */
@@ -141,6 +153,12 @@ public:
   virtual uint32_t
   GetSize () const = 0;
 
+  /**
+   * @brief Get estimate of memory used by the FIB (index, entries, and names)
+   */
+  virtual MemoryUsage
+  GetMemoryUsage () const = 0;
+
   /**
    * @brief Return first element of FIB (no order guaranteed)
    */
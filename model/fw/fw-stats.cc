@@ -85,12 +85,13 @@ FwStats::OnInterest (const Ptr<Face> &face,
 }
 
 void
-FwStats::OnData (const Ptr<Face> &face,
-                 Ptr<ContentObjectHeader> &header,
-                 Ptr<Packet> &payload,
-                 const Ptr<const Packet> &packet)
+FwStats::ProcessData (const Ptr<Face> &face,
+                      Ptr<ContentObjectHeader> &header,
+                      Ptr<Packet> &payload,
+                      const Ptr<const Packet> &packet,
+                      Ptr<pit::Entry> pitEntry)
 {
-  super::OnData (face, header, payload, packet);
+  super::ProcessData (face, header, payload, packet, pitEntry);
   
   m_stats.Rx (header->GetName ().cut (1), face, packet->GetSize ());
 
@@ -187,6 +188,8 @@ void
 FwStats::RefreshStats ()
 {
   m_stats.Step ();
+  if (m_statsTrace.IsConnected ())
+    m_stats.SyncAll (); // listeners may walk or print the whole tree
   m_statsTrace (this, m_stats);
   
   NS_LOG_DEBUG (m_stats["/"]);
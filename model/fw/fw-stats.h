@@ -23,6 +23,7 @@
 #define NDNSIM_FW_STATS_H
 
 #include "ns3/event-id.h"
+#include "ns3/counting-traced-callback.h"
 
 #include "best-route.h"
 #include "../../utils/stats-tree.h"
@@ -56,16 +57,17 @@ public:
               Ptr<InterestHeader> &header,
               const Ptr<const Packet> &p);
 
-  virtual void
-  OnData (const Ptr<Face> &face,
-          Ptr<ContentObjectHeader> &header,
-          Ptr<Packet> &payload,
-          const Ptr<const Packet> &packet);
-
   virtual void
   RemoveFace (Ptr<Face> face);
 
 protected:
+  virtual void
+  ProcessData (const Ptr<Face> &face,
+               Ptr<ContentObjectHeader> &header,
+               Ptr<Packet> &payload,
+               const Ptr<const Packet> &packet,
+               Ptr<pit::Entry> pitEntry);
+
   virtual void
   DidCreatePitEntry (const Ptr<Face> &incomingFace,
                      Ptr<InterestHeader> header,
@@ -111,8 +113,8 @@ private:
   ndnSIM::StatsTree m_stats;
   EventId m_statsRefreshEvent;
 
-  TracedCallback< Ptr<ForwardingStrategy>,
-                  const ndnSIM::StatsTree & > m_statsTrace;
+  CountingTracedCallback< Ptr<ForwardingStrategy>,
+                          const ndnSIM::StatsTree & > m_statsTrace;
   
   typedef BestRoute super;
 };
@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "locator-cache.h"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.fw.LocatorCache");
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+namespace
+{
+struct Refresh
+{
+  Refresh (const NameComponents &locator, const Time &expireTime)
+    : m_locator (locator)
+    , m_expireTime (expireTime)
+  {
+  }
+
+  template<class Entry>
+  void
+  operator () (Entry &entry) const
+  {
+    if (entry.m_locator == 0 || !(*entry.m_locator == m_locator))
+      {
+        // headers of already stamped Interests may reference the old locator, don't modify it in place
+        entry.m_locator = Create<NameComponents> (m_locator);
+      }
+    entry.m_expireTime = m_expireTime;
+  }
+
+  const NameComponents &m_locator;
+  Time m_expireTime;
+};
+} // anonymous namespace
+
+LocatorCache::LocatorCache (size_t maxSize)
+{
+  m_table.getPolicy ().set_max_size (maxSize);
+}
+
+void
+LocatorCache::Learn (const NameComponents &prefix, const NameComponents &locator, Time lifetime)
+{
+  std::pair<table::iterator, bool> result = m_table.insert (prefix, Create<Entry> ());
+  if (result.first == m_table.end ())
+    return;
+
+  m_table.modify (result.first, Refresh (locator, Simulator::Now () + lifetime));
+}
+
+Ptr<NameComponents>
+LocatorCache::Lookup (const NameComponents &name)
+{
+  Time now = Simulator::Now ();
+  Ptr<NameComponents> locator;
+
+  // expired entries are erased only after the walk, since erasing may prune their (empty) parents
+  std::vector<table::iterator> expired;
+
+  for (table::iterator item = m_table.longest_prefix_match (name);
+       item != m_table.end ();
+       item = item->parent ())
+    {
+      if (item->payload () == 0)
+        continue; // intermediate node
+
+      if (item->payload ()->m_expireTime > now)
+        {
+          if (!expired.empty ())
+            m_table.getPolicy ().lookup (item); // shorter prefix is used instead of the expired one
+
+          locator = item->payload ()->m_locator;
+          break;
+        }
+
+      expired.push_back (item);
+    }
+
+  for (std::vector<table::iterator>::iterator item = expired.begin (); item != expired.end (); item++)
+    {
+      NS_LOG_DEBUG ("Expired locator for " << name);
+      m_table.erase (*item);
+    }
+
+  return locator;
+}
+
+void
+LocatorCache::Invalidate (const NameComponents &prefix)
+{
+  m_table.erase (prefix);
+}
+
+size_t
+LocatorCache::GetMaxSize () const
+{
+  return m_table.getPolicy ().get_max_size ();
+}
+
+size_t
+LocatorCache::GetSize () const
+{
+  return m_table.getPolicy ().size ();
+}
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
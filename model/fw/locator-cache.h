@@ -0,0 +1,109 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_LOCATOR_CACHE_H
+#define NDNSIM_LOCATOR_CACHE_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/ndn-name-components.h"
+
+#include "../../utils/trie-with-policy.h"
+#include "../../utils/lru-policy.h"
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+/**
+ * \ingroup ndn
+ * \brief Bounded cache of name prefix to locator mappings of mobile producers
+ *
+ * Mappings are learned from Data packets that carry a locator (see ContentObjectHeader::GetLocator)
+ * and expire after a fixed lifetime since the last refresh.  If the cache is full,
+ * the least recently used mapping is evicted.
+ *
+ * \see ForwardingStrategy attributes LocatorCacheSize and LocatorCacheLifetime
+ */
+class LocatorCache : public SimpleRefCount<LocatorCache>
+{
+public:
+  /**
+   * @brief Create cache for at most `maxSize' mappings
+   */
+  LocatorCache (size_t maxSize);
+
+  /**
+   * @brief Add or refresh mapping of `prefix' to `locator'
+   *
+   * @param prefix   Name prefix of the producer
+   * @param locator  Current locator of the producer
+   * @param lifetime Time during which the mapping is considered valid
+   */
+  void
+  Learn (const NameComponents &prefix, const NameComponents &locator, Time lifetime);
+
+  /**
+   * @brief Find locator for the `name' (longest prefix match)
+   *
+   * If the longest matching mapping has expired, shorter prefixes of the `name' are tried.
+   * Expired mappings found during the lookup are removed from the cache
+   *
+   * @returns locator or 0, if there is no valid mapping
+   */
+  Ptr<NameComponents>
+  Lookup (const NameComponents &name);
+
+  /**
+   * @brief Remove mapping for the `prefix' (exact match)
+   */
+  void
+  Invalidate (const NameComponents &prefix);
+
+  /**
+   * @brief Get maximum number of mappings
+   */
+  size_t
+  GetMaxSize () const;
+
+  /**
+   * @brief Get current number of mappings (including expired that were not yet looked up)
+   */
+  size_t
+  GetSize () const;
+
+private:
+  struct Entry : public SimpleRefCount<Entry>
+  {
+    Ptr<NameComponents> m_locator;
+    Time m_expireTime;
+  };
+
+  typedef ndnSIM::trie_with_policy< NameComponents,
+                                    ndnSIM::smart_pointer_payload_traits<Entry>,
+                                    ndnSIM::lru_policy_traits > table;
+
+  table m_table;
+};
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_LOCATOR_CACHE_H
@@ -72,6 +72,16 @@ Nacks::GetTypeId (void)
   return tid;
 }
 
+uint64_t
+Nacks::GetTraceCount (const std::string &traceName) const
+{
+  if (traceName == "OutNacks")       return m_outNacks.GetCount ();
+  else if (traceName == "InNacks")   return m_inNacks.GetCount ();
+  else if (traceName == "DropNacks") return m_dropNacks.GetCount ();
+  else
+    return super::GetTraceCount (traceName);
+}
+
 void
 Nacks::OnInterest (const Ptr<Face> &incomingFace,
                    Ptr<InterestHeader> &header,
@@ -87,13 +97,21 @@ void
 Nacks::OnNack (const Ptr<Face> &incomingFace,
                Ptr<InterestHeader> &header,
                const Ptr<const Packet> &packet)
+{
+  ProcessNack (incomingFace, header, packet, m_pit->Lookup (*header));
+}
+
+void
+Nacks::ProcessNack (const Ptr<Face> &incomingFace,
+                    Ptr<InterestHeader> &header,
+                    const Ptr<const Packet> &packet,
+                    Ptr<pit::Entry> pitEntry)
 {
   NS_ASSERT (m_nacksEnabled);
 
   // NS_LOG_FUNCTION (incomingFace << header << packet);
   m_inNacks (header, incomingFace);
 
-  Ptr<pit::Entry> pitEntry = m_pit->Lookup (*header);
   if (pitEntry == 0)
     {
       // somebody is doing something bad
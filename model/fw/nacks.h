@@ -50,6 +50,9 @@ public:
               Ptr<InterestHeader> &header,
               const Ptr<const Packet> &p);
 
+  virtual uint64_t
+  GetTraceCount (const std::string &traceName) const;
+
 protected:
   // using NdnForwardingStrategy::PropagateInterest; // some strange c++ cheating
 
@@ -70,6 +73,17 @@ protected:
           Ptr<InterestHeader> &header,
           const Ptr<const Packet> &p);
 
+  /**
+   * \brief Processing of incoming NACK, for which PIT has already been looked up
+   *
+   * @param pitEntry PIT entry of the NACKed Interest (0 if there is none)
+   */
+  virtual void
+  ProcessNack (const Ptr<Face> &face,
+               Ptr<InterestHeader> &header,
+               const Ptr<const Packet> &p,
+               Ptr<pit::Entry> pitEntry);
+
   virtual void
   DidReceiveValidNack (const Ptr<Face> &incomingFace,
                        uint32_t nackCode,
@@ -78,14 +92,16 @@ protected:
 protected:  
   bool m_nacksEnabled;
 
-  TracedCallback<Ptr<const InterestHeader>,
-                 Ptr<const Face> > m_outNacks; ///< @brief trace of outgoing NACKs
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_outNacks; ///< @brief trace of outgoing NACKs
+
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_inNacks; ///< @brief trace of incoming NACKs
 
-  TracedCallback<Ptr<const InterestHeader>,
-                 Ptr<const Face> > m_inNacks; ///< @brief trace of incoming NACKs
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_dropNacks; ///< @brief trace of dropped NACKs
 
-  TracedCallback<Ptr<const InterestHeader>,
-                 Ptr<const Face> > m_dropNacks; ///< @brief trace of dropped NACKs
+  friend class StrategyChoice; // passes PIT entry of the NACK it has already looked up
 
 private:
   typedef ForwardingStrategy super;
@@ -36,12 +36,16 @@
 #include "ns3/ndn-content-store.h"
 #include "ns3/ndn-face.h"
 
+#include "locator-cache.h"
+#include "../../utils/stage-profiler.h"
+
 #include "ns3/assert.h"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/boolean.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <boost/ref.hpp>
 #include <boost/foreach.hpp>
@@ -69,6 +73,8 @@ TypeId ForwardingStrategy::GetTypeId (void)
     .AddTraceSource ("OutInterests",  "OutInterests",  MakeTraceSourceAccessor (&ForwardingStrategy::m_outInterests))
     .AddTraceSource ("InInterests",   "InInterests",   MakeTraceSourceAccessor (&ForwardingStrategy::m_inInterests))
     .AddTraceSource ("DropInterests", "DropInterests", MakeTraceSourceAccessor (&ForwardingStrategy::m_dropInterests))
+    .AddTraceSource ("LocatorStampedInterests", "Interests stamped with locator from the locator cache",
+                     MakeTraceSourceAccessor (&ForwardingStrategy::m_locatorStampedInterests))
     
     ////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////
@@ -87,6 +93,19 @@ TypeId ForwardingStrategy::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&ForwardingStrategy::m_detectRetransmissions),
                    MakeBooleanChecker ())
+
+    .AddAttribute ("LocatorCacheSize", "Maximum number of name-to-locator mappings learned from Data of mobile producers. "
+                                       "Interests without locator that match a mapping are stamped with the locator "
+                                       "and forwarded towards it directly. 0 disables the cache",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ForwardingStrategy::SetLocatorCacheSize,
+                                         &ForwardingStrategy::GetLocatorCacheSize),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("LocatorCacheLifetime", "Time since the last Data with the locator, during which the mapping is used",
+                   StringValue ("1s"),
+                   MakeTimeAccessor (&ForwardingStrategy::m_locatorCacheLifetime),
+                   MakeTimeChecker ())
     ;
   return tid;
 }
@@ -114,6 +133,10 @@ ForwardingStrategy::NotifyNewAggregate ()
     {
       m_contentStore = GetObject<ContentStore> ();
     }
+  if (m_profiler == 0)
+    {
+      m_profiler = GetObject<StageProfiler> ();
+    }
 
   Object::NotifyNewAggregate ();
 }
@@ -124,23 +147,97 @@ ForwardingStrategy::DoDispose ()
   m_pit = 0;
   m_contentStore = 0;
   m_fib = 0;
+  m_profiler = 0;
+  m_locatorCache = 0;
 
   Object::DoDispose ();
 }
 
+void
+ForwardingStrategy::SetLocatorCacheSize (uint32_t size)
+{
+  if (size == 0)
+    m_locatorCache = 0;
+  else
+    m_locatorCache = Create<fw::LocatorCache> (size);
+}
+
+uint32_t
+ForwardingStrategy::GetLocatorCacheSize () const
+{
+  if (m_locatorCache == 0)
+    return 0;
+
+  return m_locatorCache->GetMaxSize ();
+}
+
+void
+ForwardingStrategy::LearnLocator (const ContentObjectHeader &header)
+{
+  if (m_locatorCache == 0 ||
+      !header.IsEnabledLocator () || header.GetLocator ().size () == 0 ||
+      header.GetPosition () < 0 ||
+      header.GetName ().size () < 2)
+    return;
+
+  // the last component is the sequence number, the rest is the prefix of the producer
+  m_locatorCache->Learn (header.GetName ().cut (1), header.GetLocator (), m_locatorCacheLifetime);
+}
+
+void
+ForwardingStrategy::OnInterests (const Ptr<Face> &incomingFace,
+                                 const InterestBatch &batch)
+{
+  for (InterestBatch::const_iterator i = batch.begin (); i != batch.end (); i++)
+    {
+      Ptr<InterestHeader> header = i->first;
+      OnInterest (incomingFace, header, i->second);
+    }
+}
+
 void
 ForwardingStrategy::OnInterest (const Ptr<Face> &incomingFace,
                                     Ptr<InterestHeader> &header,
                                     const Ptr<const Packet> &packet)
 {
+  if (m_locatorCache != 0 &&
+      !(header->IsEnabledLocator () && header->GetLocator ().size () > 0))
+    {
+      Ptr<NameComponents> locator = m_locatorCache->Lookup (header->GetName ());
+      if (locator != 0)
+        {
+          // Forward directly towards the producer instead of the triangle via its agent
+          header->SetLocator (locator);
+          header->SetAgent (2);
+
+          Ptr<Packet> stampedPacket = Create<Packet> ();
+          stampedPacket->AddHeader (*header);
+
+          m_locatorStampedInterests (header, incomingFace);
+          // non-virtual: derived strategies have already seen this Interest
+          ForwardingStrategy::OnInterest (incomingFace, header, stampedPacket);
+          return;
+        }
+    }
+
     m_inInterests (header, incomingFace);
 
-    Ptr<pit::Entry> pitEntry = m_pit->Lookup (*header);
-    if (pitEntry == 0)
+    Ptr<pit::Entry> pitEntry;
+    bool isNew = false;
+    {
+      NDN_PROFILE_STAGE (m_profiler, PIT);
+      pitEntry = m_pit->Lookup (*header);
+      if (pitEntry == 0)
+        {
+          pitEntry = m_pit->Create (header);
+          isNew = true;
+        }
+    }
+    if (isNew)
     {
-      pitEntry = m_pit->Create (header);
       if (pitEntry != 0)
       {
+        pitEntry->SetStrategy (this);
         DidCreatePitEntry (incomingFace, header, packet, pitEntry);
       }
       else
@@ -152,7 +249,11 @@ ForwardingStrategy::OnInterest (const Ptr<Face> &incomingFace,
 	
   if( header->GetAgent()>0)
   {
-      Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatchOfLocator (*header);
+      Ptr<fib::Entry> fibEntry;
+      {
+        NDN_PROFILE_STAGE (m_profiler, FIB);
+        fibEntry = m_fib->LongestPrefixMatchOfLocator (*header);
+      }
       if (!(fibEntry == 0))
       	{
          pitEntry->SetFibEntry(fibEntry);
@@ -178,7 +279,10 @@ ForwardingStrategy::OnInterest (const Ptr<Face> &incomingFace,
     Ptr<const ContentObjectHeader> contentObjectHeader; // used for tracing
     Ptr<const Packet> payload; // used for tracing
 
-    boost::tie (contentObject, contentObjectHeader, payload) = m_contentStore->Lookup (header);
+    {
+      NDN_PROFILE_STAGE (m_profiler, CONTENT_STORE);
+      boost::tie (contentObject, contentObjectHeader, payload) = m_contentStore->Lookup (header);
+    }
   
     if (contentObject != 0)
     {
@@ -215,12 +319,27 @@ ForwardingStrategy::OnData (const Ptr<Face> &incomingFace,
                                 Ptr<ContentObjectHeader> &header,
                                 Ptr<Packet> &payload,
                                 const Ptr<const Packet> &packet)
+{
+  // Lookup PIT entry
+  Ptr<pit::Entry> pitEntry;
+  {
+    NDN_PROFILE_STAGE (m_profiler, PIT);
+    pitEntry = m_pit->Lookup (*header);
+  }
+
+  ProcessData (incomingFace, header, payload, packet, pitEntry);
+}
+
+void
+ForwardingStrategy::ProcessData (const Ptr<Face> &incomingFace,
+                                 Ptr<ContentObjectHeader> &header,
+                                 Ptr<Packet> &payload,
+                                 const Ptr<const Packet> &packet,
+                                 Ptr<pit::Entry> pitEntry)
 {
   NS_LOG_FUNCTION (incomingFace << header->GetName () << payload << packet);
   m_inData (header, payload, incomingFace);
   
-  // Lookup PIT entry
-  Ptr<pit::Entry> pitEntry = m_pit->Lookup (*header);
   if (pitEntry == 0)
     {
       DidReceiveUnsolicitedData (incomingFace, header, payload);
@@ -228,10 +347,13 @@ ForwardingStrategy::OnData (const Ptr<Face> &incomingFace,
     }
   else
     {
+      NDN_PROFILE_STAGE (m_profiler, CONTENT_STORE);
       // Add or update entry in the content store
       m_contentStore->Add (header, payload);
     }
 
+  LearnLocator (*header);
+
   while (pitEntry != 0)
     {
       // Do data plane performance measurements
@@ -433,13 +555,18 @@ ForwardingStrategy::PropagateInterest (const Ptr<Face> &incomingFace,
   /// @todo Make lifetime per incoming interface
   pitEntry->UpdateLifetime (header->GetInterestLifetime ());
   
-  bool propagated = DoPropagateInterest (incomingFace, header, packet, pitEntry);
+  bool propagated;
+  {
+    NDN_PROFILE_STAGE (m_profiler, PROPAGATE);
+    propagated = DoPropagateInterest (incomingFace, header, packet, pitEntry);
+  }
 
   if (!propagated && isRetransmitted) //give another chance if retransmitted
     {
       // increase max number of allowed retransmissions
       pitEntry->IncreaseAllowedRetxCount ();
 
+      NDN_PROFILE_STAGE (m_profiler, PROPAGATE);
       // try again
       propagated = DoPropagateInterest (incomingFace, header, packet, pitEntry);
     }
@@ -507,5 +634,19 @@ ForwardingStrategy::RemoveFace (Ptr<Face> face)
   // do nothing here
 }
 
+uint64_t
+ForwardingStrategy::GetTraceCount (const std::string &traceName) const
+{
+  if (traceName == "OutInterests")       return m_outInterests.GetCount ();
+  else if (traceName == "InInterests")   return m_inInterests.GetCount ();
+  else if (traceName == "DropInterests") return m_dropInterests.GetCount ();
+  else if (traceName == "LocatorStampedInterests") return m_locatorStampedInterests.GetCount ();
+  else if (traceName == "OutData")       return m_outData.GetCount ();
+  else if (traceName == "InData")        return m_inData.GetCount ();
+  else if (traceName == "DropData")      return m_dropData.GetCount ();
+  else
+    return 0;
+}
+
 } // namespace ndn
 } // namespace ns3
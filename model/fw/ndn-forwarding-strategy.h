@@ -31,7 +31,10 @@
 #include "ns3/packet.h"
 #include "ns3/callback.h"
 #include "ns3/object.h"
+#include "ns3/nstime.h"
 #include "ns3/traced-callback.h"
+#include "ns3/counting-traced-callback.h"
+#include "ns3/ndn-face.h"
 
 namespace ns3 {
 namespace ndn {
@@ -44,6 +47,8 @@ namespace pit { class Entry; }
 class FibFaceMetric;
 class Fib;
 class ContentStore;
+class StageProfiler;
+namespace fw { class StrategyChoice; class LocatorCache; }
 
 /**
  * \ingroup ndn
@@ -74,6 +79,19 @@ public:
               Ptr<InterestHeader> &header,
               const Ptr<const Packet> &p);
 
+  /**
+   * \brief Processing of a batch of already decoded Interests received on the same face
+   *
+   * Default implementation calls OnInterest for each Interest back-to-back.  Strategies may override
+   * it to amortize per-Interest lookups
+   *
+   * @param face    incoming face
+   * @param batch   deserialized Interest headers with original packets
+   */
+  virtual void
+  OnInterests (const Ptr<Face> &face,
+               const InterestBatch &batch);
+
   /**
    * \brief Actual processing of incoming Ndn content objects
    * 
@@ -94,8 +112,32 @@ public:
 
   virtual void
   RemoveFace (Ptr<Face> face);
+
+  /**
+   * @brief Get number of times trace source `traceName' (e.g., "OutInterests") was fired
+   *
+   * Counters are maintained even when nothing is connected to the trace source or when
+   * TraceMode::SetCountersOnly is enabled.  Zero is returned for unknown trace sources
+   */
+  virtual uint64_t
+  GetTraceCount (const std::string &traceName) const;
   
 protected:
+  /**
+   * \brief Processing of incoming content object, for which PIT has already been looked up
+   *
+   * OnData looks up the PIT and calls this method.  Strategies that extend processing of incoming
+   * content objects should override this method rather than OnData (StrategyChoice calls it directly)
+   *
+   * @param pitEntry first PIT entry matching the content object (0 for unsolicited data)
+   */
+  virtual void
+  ProcessData (const Ptr<Face> &face,
+               Ptr<ContentObjectHeader> &header,
+               Ptr<Packet> &payload,
+               const Ptr<const Packet> &packet,
+               Ptr<pit::Entry> pitEntry);
+
   // events
   virtual void
   DidReceiveDuplicateInterest (const Ptr<Face> &face,
@@ -199,37 +241,59 @@ protected:
   // inherited from Object class                                                                                                                                                        
   virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
   virtual void DoDispose (); ///< @brief Do cleanup
+
+  friend class fw::StrategyChoice; // dispatches events to strategies that are not aggregated to the node
+
+private:
+  void
+  SetLocatorCacheSize (uint32_t size);
+
+  uint32_t
+  GetLocatorCacheSize () const;
+
+  /**
+   * @brief Learn locator of the producer from Data, if locator cache is enabled
+   */
+  void
+  LearnLocator (const ContentObjectHeader &header);
   
 protected:  
   Ptr<Pit> m_pit; ///< \brief Reference to PIT to which this forwarding strategy is associated
   Ptr<Fib> m_fib; ///< \brief FIB  
   Ptr<ContentStore> m_contentStore; ///< \brief Content store (for caching purposes only)
+  Ptr<StageProfiler> m_profiler; ///< \brief Optional profiler of forwarding stages (see NDN_PROFILE_STAGE)
 
   bool m_cacheUnsolicitedData;
   bool m_detectRetransmissions;
+
+  Ptr<fw::LocatorCache> m_locatorCache; ///< @brief Optional cache of producer locators learned from Data (LocatorCacheSize > 0)
+  Time m_locatorCacheLifetime;
   
-  TracedCallback<Ptr<const InterestHeader>,
-                 Ptr<const Face> > m_outInterests; ///< @brief Transmitted interests trace
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_outInterests; ///< @brief Transmitted interests trace
+
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_inInterests; ///< @brief trace of incoming Interests
 
-  TracedCallback<Ptr<const InterestHeader>,
-                 Ptr<const Face> > m_inInterests; ///< @brief trace of incoming Interests
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_dropInterests; ///< @brief trace of dropped Interests
 
-  TracedCallback<Ptr<const InterestHeader>,
-                 Ptr<const Face> > m_dropInterests; ///< @brief trace of dropped Interests
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_locatorStampedInterests; ///< @brief trace of Interests stamped with locator from the locator cache
   
   ////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////
 
-  TracedCallback<Ptr<const ContentObjectHeader>, Ptr<const Packet>,
-                 bool /*from cache*/,
-                 Ptr<const Face> > m_outData; ///< @brief trace of outgoing Data
+  CountingTracedCallback<Ptr<const ContentObjectHeader>, Ptr<const Packet>,
+                         bool /*from cache*/,
+                         Ptr<const Face> > m_outData; ///< @brief trace of outgoing Data
 
-  TracedCallback<Ptr<const ContentObjectHeader>, Ptr<const Packet>,
-                 Ptr<const Face> > m_inData; ///< @brief trace of incoming Data
+  CountingTracedCallback<Ptr<const ContentObjectHeader>, Ptr<const Packet>,
+                         Ptr<const Face> > m_inData; ///< @brief trace of incoming Data
 
-  TracedCallback<Ptr<const ContentObjectHeader>, Ptr<const Packet>,
-                  Ptr<const Face> > m_dropData;  ///< @brief trace of dropped Data
+  CountingTracedCallback<Ptr<const ContentObjectHeader>, Ptr<const Packet>,
+                         Ptr<const Face> > m_dropData;  ///< @brief trace of dropped Data
 };
 
 } // namespace ndn
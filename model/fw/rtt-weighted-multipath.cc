@@ -0,0 +1,264 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "rtt-weighted-multipath.h"
+
+#include "ns3/ndn-interest-header.h"
+#include "ns3/ndn-pit.h"
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-fib.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <boost/foreach.hpp>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.fw.RttWeightedMultipath");
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+NS_OBJECT_ENSURE_REGISTERED (RttWeightedMultipath);
+
+TypeId
+RttWeightedMultipath::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fw::RttWeightedMultipath")
+    .SetGroupName ("Ndn")
+    .SetParent <Nacks> ()
+    .AddConstructor <RttWeightedMultipath> ()
+
+    .AddAttribute ("ProbingInterval", "Interval between probing of faces other than the best one",
+                   StringValue ("1s"),
+                   MakeTimeAccessor (&RttWeightedMultipath::m_probingInterval),
+                   MakeTimeChecker ())
+    ;
+  return tid;
+}
+
+RttWeightedMultipath::RttWeightedMultipath ()
+{
+}
+
+void
+RttWeightedMultipath::DoDispose ()
+{
+  m_probingEvent.Cancel ();
+  m_inFlight.clear ();
+
+  super::DoDispose ();
+}
+
+uint32_t
+RttWeightedMultipath::GetInFlight (Ptr<Face> face) const
+{
+  InFlightMap::const_iterator item = m_inFlight.find (face);
+  if (item == m_inFlight.end ())
+    return 0;
+  else
+    return item->second;
+}
+
+bool
+RttWeightedMultipath::DoPropagateInterest (const Ptr<Face> &incomingFace,
+                                           Ptr<InterestHeader> header,
+                                           const Ptr<const Packet> &packet,
+                                           Ptr<pit::Entry> pitEntry)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_probingEvent.IsRunning ())
+    m_probingEvent = Simulator::Schedule (m_probingInterval, &RttWeightedMultipath::RequestProbing, this);
+
+  Ptr<fib::Entry> fibEntry = pitEntry->GetFibEntry ();
+
+  std::vector< std::pair< Ptr<Face>, double > > candidates;
+  Time bestRtt = Seconds (0);
+  BOOST_FOREACH (const fib::FaceMetric &metricFace, fibEntry->m_faces.get<fib::i_metric> ())
+    {
+      if (metricFace.m_status == fib::FaceMetric::NDN_FIB_RED) // all non-red faces are in front
+        break;
+
+      if (metricFace.m_face == incomingFace)
+        continue; // same face as incoming, don't forward
+
+      if (pitEntry->GetIncoming ().find (metricFace.m_face) != pitEntry->GetIncoming ().end ())
+        continue; // don't forward to face that we received interest from
+
+      if (!metricFace.m_sRtt.IsZero () && (bestRtt.IsZero () || metricFace.m_sRtt < bestRtt))
+        bestRtt = metricFace.m_sRtt;
+
+      candidates.push_back (std::make_pair (metricFace.m_face, metricFace.m_sRtt.ToDouble (Time::S)));
+    }
+
+  if (candidates.empty ())
+    return false;
+
+  // weight is inversely proportional to expected delay: RTT scaled by the face's queue of pending Interests
+  double unknownRtt = bestRtt.IsZero () ? 1.0 : bestRtt.ToDouble (Time::S);
+  double totalWeight = 0;
+  uint32_t bestCandidate = 0;
+  for (uint32_t i = 0; i < candidates.size (); i++)
+    {
+      double rtt = candidates[i].second > 0 ? candidates[i].second : unknownRtt;
+      candidates[i].second = 1.0 / (rtt * (1 + GetInFlight (candidates[i].first)));
+      totalWeight += candidates[i].second;
+
+      if (candidates[i].second > candidates[bestCandidate].second)
+        bestCandidate = i;
+    }
+
+  if (fibEntry->m_needsProbing && candidates.size () > 1)
+    {
+      fibEntry->m_needsProbing = false;
+
+      // send this Interest via a random face other than the best one
+      candidates.erase (candidates.begin () + bestCandidate);
+      for (uint32_t i = 0; i < candidates.size (); i++)
+        {
+          candidates[i].second = 1.0;
+        }
+      totalWeight = candidates.size ();
+      NS_LOG_DEBUG ("Probing " << candidates.size () << " non-best faces");
+    }
+
+  while (!candidates.empty ())
+    {
+      double point = m_random.GetValue (0, totalWeight);
+      uint32_t selected = 0;
+      for (; selected < candidates.size () - 1; selected++)
+        {
+          point -= candidates[selected].second;
+          if (point < 0)
+            break;
+        }
+
+      Ptr<Face> face = candidates[selected].first;
+
+      pit::Entry::out_iterator outgoing = pitEntry->GetOutgoing ().find (face);
+      bool isPending = outgoing != pitEntry->GetOutgoing ().end () && !outgoing->m_waitingInVain;
+
+      if (WillSendOutInterest (face, header, pitEntry))
+        {
+          //transmission
+          Ptr<Packet> packetToSend = packet->Copy ();
+          face->Send (packetToSend);
+
+          DidSendOutInterest (face, header, packet, pitEntry);
+
+          if (!isPending)
+            m_inFlight[face] ++;
+
+          NS_LOG_INFO ("Propagated to " << *face);
+          return true;
+        }
+
+      totalWeight -= candidates[selected].second;
+      candidates.erase (candidates.begin () + selected);
+    }
+
+  return false;
+}
+
+void
+RttWeightedMultipath::DecreaseInFlight (Ptr<Face> face)
+{
+  InFlightMap::iterator item = m_inFlight.find (face);
+  if (item != m_inFlight.end () && item->second > 0)
+    item->second --;
+}
+
+void
+RttWeightedMultipath::ReleaseOutgoing (Ptr<pit::Entry> pitEntry)
+{
+  BOOST_FOREACH (const pit::OutgoingFace &outgoing, pitEntry->GetOutgoing ())
+    {
+      if (!outgoing.m_waitingInVain)
+        DecreaseInFlight (outgoing.m_face);
+    }
+}
+
+void
+RttWeightedMultipath::WillSatisfyPendingInterest (const Ptr<Face> &incomingFace,
+                                                  Ptr<pit::Entry> pitEntry)
+{
+  ReleaseOutgoing (pitEntry);
+
+  super::WillSatisfyPendingInterest (incomingFace, pitEntry);
+}
+
+void
+RttWeightedMultipath::DidReceiveValidNack (const Ptr<Face> &incomingFace,
+                                           uint32_t nackCode,
+                                           Ptr<pit::Entry> pitEntry)
+{
+  // Nacks::OnNack has already marked the outgoing face as waiting in vain
+  DecreaseInFlight (incomingFace);
+
+  super::DidReceiveValidNack (incomingFace, nackCode, pitEntry);
+}
+
+void
+RttWeightedMultipath::DidExhaustForwardingOptions (const Ptr<Face> &incomingFace,
+                                                   Ptr<InterestHeader> header,
+                                                   const Ptr<const Packet> &packet,
+                                                   Ptr<pit::Entry> pitEntry)
+{
+  if (m_nacksEnabled)
+    ReleaseOutgoing (pitEntry); // outgoing faces will be cleared
+
+  super::DidExhaustForwardingOptions (incomingFace, header, packet, pitEntry);
+}
+
+void
+RttWeightedMultipath::WillErasePendingInterest (Ptr<pit::Entry> pitEntry)
+{
+  ReleaseOutgoing (pitEntry);
+
+  super::WillErasePendingInterest (pitEntry);
+}
+
+void
+RttWeightedMultipath::RemoveFace (Ptr<Face> face)
+{
+  m_inFlight.erase (face);
+
+  super::RemoveFace (face);
+}
+
+void
+RttWeightedMultipath::RequestProbing ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (Ptr<const fib::Entry> entry = m_fib->Begin ();
+       entry != m_fib->End ();
+       entry = m_fib->Next (entry))
+    {
+      ConstCast<fib::Entry> (entry)->m_needsProbing = true;
+    }
+  // next probing is scheduled by the next Interest, so idle nodes do not generate events
+}
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
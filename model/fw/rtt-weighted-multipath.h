@@ -0,0 +1,127 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_RTT_WEIGHTED_MULTIPATH_H
+#define NDNSIM_RTT_WEIGHTED_MULTIPATH_H
+
+#include "nacks.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable.h"
+
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+/**
+ * \ingroup ndn
+ * \brief Adaptive multipath strategy splitting Interests between FIB faces according to RTT
+ *
+ * Each Interest is sent to one non-RED face, which is selected randomly with weight
+ * inversely proportional to smoothed RTT of the face (FaceMetric::m_sRtt) multiplied by
+ * number of Interests currently in-flight on this face.  Faces without RTT estimate are
+ * assigned the best known RTT, so they get a chance to be measured.
+ *
+ * Every ProbingInterval all FIB entries are marked for probing, and the next Interest for
+ * each marked entry is sent to one of the faces other than the currently best one
+ */
+class RttWeightedMultipath :
+    public Nacks
+{
+public:
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  RttWeightedMultipath ();
+
+  virtual void
+  WillErasePendingInterest (Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  RemoveFace (Ptr<Face> face);
+
+  /**
+   * @brief Get number of Interests that were sent out via `face' and are still pending
+   */
+  uint32_t
+  GetInFlight (Ptr<Face> face) const;
+
+protected:
+  virtual bool
+  DoPropagateInterest (const Ptr<Face> &incomingFace,
+                       Ptr<InterestHeader> header,
+                       const Ptr<const Packet> &packet,
+                       Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  WillSatisfyPendingInterest (const Ptr<Face> &incomingFace,
+                              Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  DidReceiveValidNack (const Ptr<Face> &incomingFace,
+                       uint32_t nackCode,
+                       Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  DidExhaustForwardingOptions (const Ptr<Face> &incomingFace,
+                               Ptr<InterestHeader> header,
+                               const Ptr<const Packet> &packet,
+                               Ptr<pit::Entry> pitEntry);
+
+  // from Object
+  virtual void
+  DoDispose ();
+
+private:
+  /**
+   * @brief Decrease in-flight counters for all outgoing faces of the PIT entry that are still expecting data
+   */
+  void
+  ReleaseOutgoing (Ptr<pit::Entry> pitEntry);
+
+  void
+  DecreaseInFlight (Ptr<Face> face);
+
+  /**
+   * @brief Mark all FIB entries for probing
+   */
+  void
+  RequestProbing ();
+
+private:
+  typedef std::map< Ptr<Face>, uint32_t > InFlightMap;
+  InFlightMap m_inFlight; ///< \brief number of pending Interests per face
+
+  Time m_probingInterval;
+  EventId m_probingEvent;
+  UniformVariable m_random;
+
+  typedef Nacks super;
+};
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_RTT_WEIGHTED_MULTIPATH_H
@@ -0,0 +1,311 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "strategy-choice.h"
+
+#include "ns3/ndn-pit.h"
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-content-store.h"
+
+#include "locator-cache.h"
+#include "nacks.h"
+#include "../../utils/stage-profiler.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/object-factory.h"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.fw.StrategyChoice");
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+NS_OBJECT_ENSURE_REGISTERED (StrategyChoice);
+
+TypeId
+StrategyChoice::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fw::StrategyChoice")
+    .SetGroupName ("Ndn")
+    .SetParent <ForwardingStrategy> ()
+    .AddConstructor <StrategyChoice> ()
+
+    .AddAttribute ("DefaultStrategy", "Strategy for Interests that do not match any prefix in the table",
+                   StringValue ("ns3::ndn::fw::Flooding"),
+                   MakeStringAccessor (&StrategyChoice::m_defaultStrategy),
+                   MakeStringChecker ())
+
+    .AddTraceSource ("OutNacks",  "OutNacks",  MakeTraceSourceAccessor (&StrategyChoice::m_outNacks))
+    .AddTraceSource ("InNacks",   "InNacks",   MakeTraceSourceAccessor (&StrategyChoice::m_inNacks))
+    .AddTraceSource ("DropNacks", "DropNacks", MakeTraceSourceAccessor (&StrategyChoice::m_dropNacks))
+    ;
+  return tid;
+}
+
+StrategyChoice::StrategyChoice ()
+{
+}
+
+void
+StrategyChoice::NotifyNewAggregate ()
+{
+  ForwardingStrategy::NotifyNewAggregate ();
+
+  if (m_table.getTrie ().payload () == 0)
+    {
+      SetStrategy ("/", m_defaultStrategy);
+    }
+
+  table::parent_trie::recursive_iterator item (m_table.getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      item->payload ()->m_pit = m_pit;
+      item->payload ()->m_fib = m_fib;
+      item->payload ()->m_contentStore = m_contentStore;
+      item->payload ()->m_profiler = m_profiler;
+    }
+}
+
+void
+StrategyChoice::DoDispose ()
+{
+  table::parent_trie::recursive_iterator item (m_table.getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      Detach (item->payload ());
+      item->payload ()->Dispose ();
+    }
+  m_table.clear ();
+
+  ForwardingStrategy::DoDispose ();
+}
+
+void
+StrategyChoice::Attach (Ptr<ForwardingStrategy> strategy)
+{
+  strategy->m_pit = m_pit;
+  strategy->m_fib = m_fib;
+  strategy->m_contentStore = m_contentStore;
+  strategy->m_profiler = m_profiler;
+
+  if (m_locatorCache != 0 && strategy->m_locatorCache == 0)
+    {
+      // strategies without own locator cache share the one of the table
+      strategy->m_locatorCache = m_locatorCache;
+      strategy->m_locatorCacheLifetime = m_locatorCacheLifetime;
+    }
+
+  MirrorTraces (strategy, true);
+}
+
+void
+StrategyChoice::Detach (Ptr<ForwardingStrategy> strategy)
+{
+  MirrorTraces (strategy, false);
+}
+
+void
+StrategyChoice::MirrorTraces (Ptr<ForwardingStrategy> strategy, bool enable)
+{
+  // strategy traces stay unconnected (and cheap), unless somebody connects to them directly
+  strategy->m_outInterests.SetMirror (enable ? &m_outInterests : 0);
+  strategy->m_inInterests.SetMirror (enable ? &m_inInterests : 0);
+  strategy->m_dropInterests.SetMirror (enable ? &m_dropInterests : 0);
+  strategy->m_locatorStampedInterests.SetMirror (enable ? &m_locatorStampedInterests : 0);
+
+  strategy->m_outData.SetMirror (enable ? &m_outData : 0);
+  strategy->m_inData.SetMirror (enable ? &m_inData : 0);
+  strategy->m_dropData.SetMirror (enable ? &m_dropData : 0);
+
+  Ptr<Nacks> nacks = DynamicCast<Nacks> (strategy);
+  if (nacks != 0)
+    {
+      nacks->m_outNacks.SetMirror (enable ? &m_outNacks : 0);
+      nacks->m_inNacks.SetMirror (enable ? &m_inNacks : 0);
+      nacks->m_dropNacks.SetMirror (enable ? &m_dropNacks : 0);
+    }
+}
+
+void
+StrategyChoice::SetStrategy (const NameComponents &prefix, Ptr<ForwardingStrategy> strategy)
+{
+  NS_LOG_FUNCTION (this << prefix << strategy->GetInstanceTypeId ().GetName ());
+  NS_ASSERT_MSG (DynamicCast<StrategyChoice> (strategy) == 0, "StrategyChoice cannot be nested");
+
+  std::pair< table::iterator, bool > result = m_table.insert (prefix, strategy);
+  if (!result.second)
+    {
+      if (result.first == m_table.end ())
+        return;
+
+      Ptr<ForwardingStrategy> replaced = result.first->payload ();
+      result.first->set_payload (strategy);
+      if (replaced != strategy)
+        HandOver (replaced, strategy);
+    }
+
+  Attach (strategy);
+}
+
+void
+StrategyChoice::HandOver (Ptr<ForwardingStrategy> replaced, Ptr<ForwardingStrategy> strategy)
+{
+  table::parent_trie::recursive_iterator item (m_table.getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == replaced)
+        return; // still responsible for another prefix, PIT entries remain valid
+    }
+
+  Detach (replaced);
+
+  if (m_pit == 0)
+    return; // not yet aggregated, nothing is pending
+
+  // PIT entries keep only a raw pointer to the strategy, which is about to be destroyed
+  for (Ptr<pit::Entry> entry = m_pit->Begin (); entry != m_pit->End (); entry = m_pit->Next (entry))
+    {
+      if (entry->GetStrategy () == replaced)
+        entry->SetStrategy (strategy);
+    }
+}
+
+Ptr<ForwardingStrategy>
+StrategyChoice::SetStrategy (const std::string &prefix, const std::string &strategy)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (strategy);
+
+  Ptr<ForwardingStrategy> object = factory.Create<ForwardingStrategy> ();
+  SetStrategy (boost::lexical_cast<NameComponents> (prefix), object);
+  return object;
+}
+
+Ptr<ForwardingStrategy>
+StrategyChoice::FindStrategy (const NameComponents &name)
+{
+  table::iterator item = m_table.longest_prefix_match (name);
+  NS_ASSERT_MSG (item != m_table.end (), "Default strategy should always match");
+
+  return item->payload ();
+}
+
+void
+StrategyChoice::OnInterest (const Ptr<Face> &face,
+                            Ptr<InterestHeader> &header,
+                            const Ptr<const Packet> &packet)
+{
+  if (header->GetNack () != InterestHeader::NORMAL_INTEREST)
+    {
+      // NACK goes to the strategy that has forwarded the Interest, no need for the table lookup
+      Ptr<pit::Entry> pitEntry;
+      {
+        NDN_PROFILE_STAGE (m_profiler, PIT);
+        pitEntry = m_pit->Lookup (*header);
+      }
+      if (pitEntry != 0 && pitEntry->GetStrategy () != 0)
+        {
+          Ptr<Nacks> nacks = DynamicCast<Nacks> (pitEntry->GetStrategy ());
+          if (nacks != 0)
+            nacks->ProcessNack (face, header, packet, pitEntry); // don't look up the PIT again
+          else
+            pitEntry->GetStrategy ()->OnInterest (face, header, packet);
+          return;
+        }
+    }
+
+  // PIT entry will remember the strategy (ForwardingStrategy::OnInterest)
+  FindStrategy (header->GetName ())->OnInterest (face, header, packet);
+}
+
+void
+StrategyChoice::ProcessData (const Ptr<Face> &face,
+                             Ptr<ContentObjectHeader> &header,
+                             Ptr<Packet> &payload,
+                             const Ptr<const Packet> &packet,
+                             Ptr<pit::Entry> pitEntry)
+{
+  // PIT has been looked up by ForwardingStrategy::OnData, the entry is passed down as is
+  if (pitEntry != 0 && pitEntry->GetStrategy () != 0)
+    {
+      pitEntry->GetStrategy ()->ProcessData (face, header, payload, packet, pitEntry);
+    }
+  else
+    {
+      // unsolicited data
+      FindStrategy (header->GetName ())->ProcessData (face, header, payload, packet, pitEntry);
+    }
+}
+
+void
+StrategyChoice::WillErasePendingInterest (Ptr<pit::Entry> pitEntry)
+{
+  if (pitEntry->GetStrategy () != 0)
+    {
+      pitEntry->GetStrategy ()->WillErasePendingInterest (pitEntry);
+    }
+}
+
+void
+StrategyChoice::RemoveFace (Ptr<Face> face)
+{
+  table::parent_trie::recursive_iterator item (m_table.getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      item->payload ()->RemoveFace (face);
+    }
+}
+
+uint64_t
+StrategyChoice::GetTraceCount (const std::string &traceName) const
+{
+  if (traceName == "OutNacks")       return m_outNacks.GetCount ();
+  else if (traceName == "InNacks")   return m_inNacks.GetCount ();
+  else if (traceName == "DropNacks") return m_dropNacks.GetCount ();
+  else
+    return ForwardingStrategy::GetTraceCount (traceName);
+}
+
+bool
+StrategyChoice::DoPropagateInterest (const Ptr<Face> &incomingFace,
+                                     Ptr<InterestHeader> header,
+                                     const Ptr<const Packet> &packet,
+                                     Ptr<pit::Entry> pitEntry)
+{
+  // should not normally be called, all events are processed by the strategies in the table
+  Ptr<ForwardingStrategy> strategy = pitEntry->GetStrategy ();
+  if (strategy == 0)
+    strategy = FindStrategy (header->GetName ());
+
+  return strategy->DoPropagateInterest (incomingFace, header, packet, pitEntry);
+}
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,168 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_STRATEGY_CHOICE_H
+#define NDNSIM_STRATEGY_CHOICE_H
+
+#include "ns3/ndn-forwarding-strategy.h"
+#include "ns3/ndn-name-components.h"
+#include "ns3/ndn-interest-header.h"
+#include "ns3/ndn-content-object-header.h"
+
+#include "../../utils/trie-with-policy.h"
+#include "../../utils/counting-policy.h"
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+/**
+ * \ingroup ndn
+ * \brief Strategy choice table: dispatches Interests and Data to per-prefix forwarding strategies
+ *
+ * Strategy for an Interest is determined using longest prefix match in the table and is
+ * remembered in the PIT entry (pit::Entry::GetStrategy), so Data, NACKs, and PIT expiration
+ * events are delivered to the same strategy without another lookup in the table.
+ *
+ * If there is no match, the strategy specified by DefaultStrategy attribute (installed for "/") is used.
+ * Traces of all strategies in the table (including NACK traces of strategies derived from Nacks) are
+ * mirrored by the corresponding traces of StrategyChoice, without connecting anything to the traces
+ * of the strategies (see CountingTracedCallback::SetMirror).
+ * If LocatorCacheSize of StrategyChoice is set, strategies without own locator cache share the cache of the table.
+ */
+class StrategyChoice :
+    public ForwardingStrategy
+{
+public:
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  StrategyChoice ();
+
+  /**
+   * @brief Use `strategy' for all Interests under `prefix'
+   *
+   * If another strategy has been set for the same `prefix', pending Interests of the replaced
+   * strategy are handed over to `strategy'
+   *
+   * @param prefix    Name prefix
+   * @param strategy  Strategy object, which should not be aggregated to any node
+   */
+  void
+  SetStrategy (const NameComponents &prefix, Ptr<ForwardingStrategy> strategy);
+
+  /**
+   * @brief Create strategy of type `strategy' and use it for all Interests under `prefix'
+   *
+   * @param prefix    Name prefix, e.g., "/video"
+   * @param strategy  Strategy TypeId name, e.g., "ns3::ndn::fw::BestRoute"
+   * @returns created strategy (to allow further configuration)
+   */
+  Ptr<ForwardingStrategy>
+  SetStrategy (const std::string &prefix, const std::string &strategy);
+
+  /**
+   * @brief Find strategy that is responsible for the `name' (longest prefix match)
+   */
+  Ptr<ForwardingStrategy>
+  FindStrategy (const NameComponents &name);
+
+  virtual void
+  OnInterest (const Ptr<Face> &face,
+              Ptr<InterestHeader> &header,
+              const Ptr<const Packet> &p);
+
+  virtual void
+  WillErasePendingInterest (Ptr<pit::Entry> pitEntry);
+
+  virtual void
+  RemoveFace (Ptr<Face> face);
+
+  virtual uint64_t
+  GetTraceCount (const std::string &traceName) const;
+
+protected:
+  virtual void
+  ProcessData (const Ptr<Face> &face,
+               Ptr<ContentObjectHeader> &header,
+               Ptr<Packet> &payload,
+               const Ptr<const Packet> &packet,
+               Ptr<pit::Entry> pitEntry);
+
+  virtual bool
+  DoPropagateInterest (const Ptr<Face> &incomingFace,
+                       Ptr<InterestHeader> header,
+                       const Ptr<const Packet> &packet,
+                       Ptr<pit::Entry> pitEntry);
+
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  /**
+   * @brief Share PIT, FIB, and content store with `strategy' and mirror its traces
+   */
+  void
+  Attach (Ptr<ForwardingStrategy> strategy);
+
+  /**
+   * @brief Stop mirroring traces of `strategy'
+   */
+  void
+  Detach (Ptr<ForwardingStrategy> strategy);
+
+  /**
+   * @brief Make PIT entries created by `replaced' refer to `strategy'
+   */
+  void
+  HandOver (Ptr<ForwardingStrategy> replaced, Ptr<ForwardingStrategy> strategy);
+
+  /**
+   * @brief Mirror (or stop mirroring, if `enable' is false) traces of `strategy'
+   */
+  void
+  MirrorTraces (Ptr<ForwardingStrategy> strategy, bool enable);
+
+private:
+  typedef ndnSIM::trie_with_policy< NameComponents,
+                                    ndnSIM::smart_pointer_payload_traits< ForwardingStrategy >,
+                                    ndnSIM::counting_policy_traits > table;
+
+  table m_table;
+  std::string m_defaultStrategy;
+
+  // mirrors of NACK traces of strategies derived from Nacks
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_outNacks; ///< @brief trace of outgoing NACKs
+
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_inNacks; ///< @brief trace of incoming NACKs
+
+  CountingTracedCallback<Ptr<const InterestHeader>,
+                         Ptr<const Face> > m_dropNacks; ///< @brief trace of dropped NACKs
+};
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_STRATEGY_CHOICE_H
@@ -91,6 +91,17 @@ AppFace::RegisterProtocolHandler (ProtocolHandler handler)
   m_app->RegisterProtocolHandler (MakeCallback (&Face::Receive, this));
 }
 
+void
+AppFace::RegisterInterestBatchHandler (InterestBatchHandler handler)
+{
+  NS_LOG_FUNCTION (this);
+
+  Face::RegisterInterestBatchHandler (handler);
+
+  // app always gets the batch callback; Face falls back to per-packet handler if stack didn't register one
+  m_app->RegisterInterestBatchHandler (MakeCallback (&Face::ReceiveInterests, this));
+}
+
 bool
 AppFace::SendImpl (Ptr<Packet> p)
 {
@@ -62,6 +62,9 @@ public:
   virtual void
   RegisterProtocolHandler (ProtocolHandler handler);
 
+  virtual void
+  RegisterInterestBatchHandler (InterestBatchHandler handler);
+
 protected:
   virtual bool
   SendImpl (Ptr<Packet> p);
@@ -31,6 +31,8 @@
 #include "ns3/simulator.h"
 #include "ns3/random-variable.h"
 
+#include "../utils/stage-profiler.h"
+
 // #include "ns3/weights-path-stretch-tag.h"
 
 #include <boost/ref.hpp>
@@ -94,6 +96,7 @@ Face::Face (Ptr<Node> node)
   , m_bucketMax (-1.0)
   , m_bucketLeak (0.0)
   , m_protocolHandler (MakeNullCallback<void,const Ptr<Face>&,const Ptr<const Packet>&> ())
+  , m_interestBatchHandler (MakeNullCallback<void,const Ptr<Face>&,const InterestBatch&> ())
   , m_ifup (false)
   , m_id ((uint32_t)-1)
   , m_lastLeakTime (0)
@@ -133,6 +136,14 @@ Face::RegisterProtocolHandler (ProtocolHandler handler)
   m_protocolHandler = handler;
 }
 
+void
+Face::RegisterInterestBatchHandler (InterestBatchHandler handler)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_interestBatchHandler = handler;
+}
+
 bool
 Face::IsBelowLimit ()
 {
@@ -212,7 +223,11 @@ Face::Send (Ptr<Packet> packet)
   //     packet->AddPacketTag (tag);
   //   }
 
-  bool ok = SendImpl (packet);
+  bool ok;
+  {
+    NDN_PROFILE_STAGE (m_profiler, SEND);
+    ok = SendImpl (packet);
+  }
   if (ok)
     {
       m_txTrace (packet);
@@ -242,6 +257,36 @@ Face::Receive (const Ptr<const Packet> &packet)
   return true;
 }
 
+bool
+Face::ReceiveInterests (const InterestBatch &batch)
+{
+  NS_LOG_FUNCTION (boost::cref (*this) << batch.size ());
+
+  if (!IsUp ())
+    {
+      return false;
+    }
+
+  for (InterestBatch::const_iterator i = batch.begin (); i != batch.end (); i++)
+    {
+      m_rxTrace (i->second);
+    }
+
+  if (m_interestBatchHandler.IsNull ())
+    {
+      for (InterestBatch::const_iterator i = batch.begin (); i != batch.end (); i++)
+        {
+          m_protocolHandler (this, i->second);
+        }
+    }
+  else
+    {
+      m_interestBatchHandler (this, batch);
+    }
+
+  return true;
+}
+
 void
 Face::LeakBucket ()
 {
@@ -290,6 +335,12 @@ Face::GetMetric (void) const
   return m_metric;
 }
 
+void
+Face::SetProfiler (Ptr<StageProfiler> profiler)
+{
+  m_profiler = profiler;
+}
+
 /**
  * These are face states and may be distinct from 
  * NetDevice states, such as found in real implementations
@@ -303,6 +354,16 @@ Face::IsUp (void) const
   return m_ifup;
 }
 
+uint64_t
+Face::GetTraceCount (const std::string &traceName) const
+{
+  if (traceName == "NdnTx")        return m_txTrace.GetCount ();
+  else if (traceName == "NdnRx")   return m_rxTrace.GetCount ();
+  else if (traceName == "NdnDrop") return m_dropTrace.GetCount ();
+  else
+    return 0;
+}
+
 void 
 Face::SetUp (bool up/* = true*/)
 {
@@ -23,12 +23,15 @@
 
 #include <ostream>
 #include <algorithm>
+#include <vector>
+#include <utility>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/type-id.h"
 #include "ns3/traced-callback.h"
+#include "ns3/counting-traced-callback.h"
 
 namespace ns3 {
 
@@ -37,6 +40,15 @@ class Node;
 
 namespace ndn {
 
+class InterestHeader;
+class StageProfiler;
+
+/**
+ * \ingroup ndn-face
+ * \brief Already decoded Interests, each with its original (encoded) packet
+ */
+typedef std::vector< std::pair< Ptr<InterestHeader>, Ptr<const Packet> > > InterestBatch;
+
 /**
  * \ingroup ndn
  * \defgroup ndn-face Faces
@@ -66,6 +78,14 @@ public:
    */
   typedef Callback<void,const Ptr<Face>&,const Ptr<const Packet>& > ProtocolHandler;
 
+  /**
+   * \brief Ndn protocol handler for a batch of already decoded Interests
+   *
+   * \param face Face from which Interests have been received
+   * \param batch Decoded Interests with original packets
+   */
+  typedef Callback<void,const Ptr<Face>&,const InterestBatch& > InterestBatchHandler;
+
   /**
    * \brief Default constructor
    */
@@ -88,6 +108,14 @@ public:
   virtual void
   RegisterProtocolHandler (ProtocolHandler handler);
 
+  /**
+   * \brief Register callback to call when a batch of Interests arrives on the face
+   *
+   * If no handler is registered, Interests of the batch are passed one by one to the protocol handler
+   */
+  virtual void
+  RegisterInterestBatchHandler (InterestBatchHandler handler);
+
   /**
    * @brief Check if Interest limit is reached
    *
@@ -117,6 +145,14 @@ public:
    */
   bool
   Receive (const Ptr<const Packet> &p);
+
+  /**
+   * \brief Receive a batch of already decoded Interests (e.g., from application) and forward it to the Ndn stack
+   *
+   * Skips per-packet copy and decoding that is done for packets passed to Receive
+   */
+  bool
+  ReceiveInterests (const InterestBatch &batch);
   ////////////////////////////////////////////////////////////////////
 
   /**
@@ -133,6 +169,12 @@ public:
    */
   virtual uint16_t GetMetric (void) const;
 
+  /**
+   * \brief Set profiler of forwarding stages of the node (done by L3Protocol)
+   */
+  void
+  SetProfiler (Ptr<StageProfiler> profiler);
+
   /**
    * These are face states and may be distinct from actual lower-layer
    * device states, such as found in real implementations (where the
@@ -151,6 +193,14 @@ public:
   virtual bool
   IsUp () const;
 
+  /**
+   * @brief Get number of times trace source `traceName' ("NdnTx", "NdnRx", or "NdnDrop") was fired
+   *
+   * Zero is returned for unknown trace sources
+   */
+  uint64_t
+  GetTraceCount (const std::string &traceName) const;
+
   /**
    * @brief Print information about the face into the stream
    * @param os stream to write information to
@@ -246,17 +296,20 @@ protected:
   
 private:
   ProtocolHandler m_protocolHandler; ///< Callback via which packets are getting send to Ndn stack
+  InterestBatchHandler m_interestBatchHandler; ///< Callback via which batches of Interests are getting send to Ndn stack
   bool m_ifup; ///< \brief flag indicating that the interface is UP 
   uint32_t m_id; ///< \brief id of the interface in Ndn stack (per-node uniqueness)
   Time m_lastLeakTime;
   uint32_t m_metric; ///< \brief metric of the face
   bool m_randomizeLimitChecking;
 
+  Ptr<StageProfiler> m_profiler; ///< \brief Optional profiler of forwarding stages (see NDN_PROFILE_STAGE)
+
   // bool m_enableMetricTagging;
 
-  TracedCallback<Ptr<const Packet> > m_txTrace;
-  TracedCallback<Ptr<const Packet> > m_rxTrace;
-  TracedCallback<Ptr<const Packet> > m_dropTrace;
+  CountingTracedCallback<Ptr<const Packet> > m_txTrace;
+  CountingTracedCallback<Ptr<const Packet> > m_rxTrace;
+  CountingTracedCallback<Ptr<const Packet> > m_dropTrace;
 };
 
 std::ostream& operator<< (std::ostream& os, const Face &face);
@@ -97,6 +97,12 @@ GlobalRouter::GetLocalPrefixes () const
   return m_localPrefixes;
 }
 
+GlobalRouter::ShortestPathTree &
+GlobalRouter::GetShortestPathTree ()
+{
+  return m_shortestPathTree;
+}
+
 // void
 // GlobalRouter::AddIncidencyChannel (Ptr< NdnFace > face, Ptr< Channel > channel)
 // {
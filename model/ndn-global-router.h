@@ -25,6 +25,7 @@
 #include "ns3/ptr.h"
 
 #include <list>
+#include <map>
 #include <boost/tuple/tuple.hpp>
 
 namespace ns3 {
@@ -55,6 +56,10 @@ public:
    * @brief List of locally exported prefixes
    */
   typedef std::list< Ptr<NameComponents> > LocalPrefixList;
+  /**
+   * @brief Shortest path tree rooted at the router: next hop face and distance to every other router
+   */
+  typedef std::map< Ptr< GlobalRouter >, boost::tuple< Ptr< Face >, uint32_t > > ShortestPathTree;
   
   /**
    * \brief Interface ID
@@ -108,6 +113,12 @@ public:
   const LocalPrefixList &
   GetLocalPrefixes () const;
 
+  /**
+   * @brief Get shortest path tree saved during the last route calculation (empty if it was not saved)
+   */
+  ShortestPathTree &
+  GetShortestPathTree ();
+
   // ??
 protected:
   virtual void
@@ -119,6 +130,7 @@ private:
   Ptr<L3Protocol> m_ndn;
   LocalPrefixList m_localPrefixes;
   IncidencyList m_incidencies;
+  ShortestPathTree m_shortestPathTree;
 
   static uint32_t m_idCounter;
 };
@@ -41,6 +41,7 @@
 #include "ns3/ndn-forwarding-strategy.h"
 
 #include "ndn-net-device-face.h"
+#include "../utils/stage-profiler.h"
 
 #include <boost/foreach.hpp>
 
@@ -111,6 +112,20 @@ L3Protocol::NotifyNewAggregate ()
     {
       m_forwardingStrategy = GetObject<ForwardingStrategy> ();
     }
+#ifdef NDN_STAGE_PROFILER
+  if (m_profiler == 0)
+    {
+      m_profiler = GetObject<StageProfiler> ();
+      if (m_profiler != 0)
+        {
+          // StageProfiler is usually aggregated after faces are created
+          for (FaceList::iterator face = m_faces.begin (); face != m_faces.end (); face++)
+            {
+              (*face)->SetProfiler (m_profiler);
+            }
+        }
+    }
+#endif
   // if (m_contentStore == 0)
   //   {
   //     m_contentStore = GetObject<ContentStore> ();
@@ -133,6 +148,7 @@ L3Protocol::DoDispose (void)
 
   // Force delete on objects
   m_forwardingStrategy = 0; // there is a reference to PIT stored in here
+  m_profiler = 0;
 
   Object::DoDispose ();
 }
@@ -146,6 +162,11 @@ L3Protocol::AddFace (const Ptr<Face> &face)
 
   // ask face to register in lower-layer stack
   face->RegisterProtocolHandler (MakeCallback (&L3Protocol::Receive, this));
+  face->RegisterInterestBatchHandler (MakeCallback (&L3Protocol::ReceiveInterests, this));
+
+#ifdef NDN_STAGE_PROFILER
+  face->SetProfiler (m_profiler);
+#endif
 
   m_faces.push_back (face);
   m_faceCounter++;
@@ -157,6 +178,7 @@ L3Protocol::RemoveFace (Ptr<Face> face)
 {
   // ask face to register in lower-layer stack
   face->RegisterProtocolHandler (MakeNullCallback<void,const Ptr<Face>&,const Ptr<const Packet>&> ());
+  face->RegisterInterestBatchHandler (MakeNullCallback<void,const Ptr<Face>&,const InterestBatch&> ());
   Ptr<Pit> pit = GetObject<Pit> ();
 
   // just to be on a safe side. Do the process in two steps
@@ -228,15 +250,22 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
   Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
   try
     {
-      HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p);
+      HeaderHelper::Type type;
+      {
+        NDN_PROFILE_STAGE (m_profiler, DECODE);
+        type = HeaderHelper::GetNdnHeaderType (p);
+      }
       switch (type)
         {
         case HeaderHelper::INTEREST:
           {
             Ptr<InterestHeader> header = Create<InterestHeader> ();
 
-            // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
+            {
+              NDN_PROFILE_STAGE (m_profiler, DECODE);
+              // Deserialization. Exception may be thrown
+              packet->RemoveHeader (*header);
+            }
             NS_ASSERT_MSG (packet->GetSize () == 0, "Payload of Interests should be zero");
 
             m_forwardingStrategy->OnInterest (face, header, p/*original packet*/);
@@ -252,9 +281,12 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
             
             static ContentObjectTail contentObjectTrailer; //there is no data in this object
 
-            // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
-            packet->RemoveTrailer (contentObjectTrailer);
+            {
+              NDN_PROFILE_STAGE (m_profiler, DECODE);
+              // Deserialization. Exception may be thrown
+              packet->RemoveHeader (*header);
+              packet->RemoveTrailer (contentObjectTrailer);
+            }
 
             m_forwardingStrategy->OnData (face, header, packet/*payload*/, p/*original packet*/);  
             break;
@@ -271,6 +303,18 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
     }
 }
 
+void
+L3Protocol::ReceiveInterests (const Ptr<Face> &face, const InterestBatch &batch)
+{
+  if (!face->IsUp ())
+    return;
+
+  NS_LOG_LOGIC (batch.size () << " Interests from face " << *face << " received on node " <<  m_node->GetId ());
+
+  // Interests are already decoded
+  m_forwardingStrategy->OnInterests (face, batch);
+}
+
 
 } //namespace ndn
 } //namespace ns3
@@ -27,6 +27,7 @@
 #include "ns3/ptr.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
+#include "ns3/ndn-face.h"
 
 namespace ns3 {
 
@@ -39,6 +40,7 @@ namespace ndn {
 
 class Face;
 class ForwardingStrategy;
+class StageProfiler;
 class InterestHeader;
 class ContentObjectHeader;
 
@@ -128,6 +130,9 @@ private:
   void
   Receive (const Ptr<Face> &face, const Ptr<const Packet> &p);
 
+  void
+  ReceiveInterests (const Ptr<Face> &face, const InterestBatch &batch);
+
 protected:
   virtual void DoDispose (void); ///< @brief Do cleanup
 
@@ -149,6 +154,7 @@ private:
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
   Ptr<ForwardingStrategy> m_forwardingStrategy; ///< \brief smart pointer to the selected forwarding strategy
+  Ptr<StageProfiler> m_profiler; ///< \brief optional profiler of forwarding stages (see NDN_PROFILE_STAGE)
 };
 
 } // namespace ndn
@@ -29,6 +29,7 @@
 #include "ns3/ndn-fib.h"
 #include "ns3/ndn-name-components.h"
 #include "ns3/ndn-interest-header.h"
+#include "ns3/ndn-forwarding-strategy.h"
 
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -50,6 +51,7 @@ Entry::Entry (Pit &container,
   : m_container (container)
   , m_prefix (header->GetNamePtr ())
   , m_fibEntry (fibEntry)
+  , m_strategy (0)
   , m_expireTime (Simulator::Now () + (!header->GetInterestLifetime ().IsZero ()?
                                        header->GetInterestLifetime ():
                                        Seconds (1.0)))
@@ -93,6 +95,18 @@ Entry::SetFibEntry (const Ptr<fib::Entry> &fibEntry)
    m_fibEntry=fibEntry;
 }
 
+Ptr<ForwardingStrategy>
+Entry::GetStrategy () const
+{
+  return m_strategy;
+}
+
+void
+Entry::SetStrategy (Ptr<ForwardingStrategy> strategy)
+{
+  m_strategy = PeekPointer (strategy);
+}
+
 Entry::out_iterator
 Entry::AddOutgoing (Ptr<Face> face)
 {
@@ -186,6 +200,15 @@ Entry::IncreaseAllowedRetxCount ()
     }
 }
 
+MemoryUsage
+Entry::GetMemoryUsage () const
+{
+  MemoryUsage usage;
+  usage.m_entries += DynamicSize (m_seenNonces) + DynamicSize (m_incoming) + DynamicSize (m_outgoing);
+  usage.m_names += sizeof (NameComponents) + DynamicSize (m_prefix->GetComponents ());
+  return usage;
+}
+
 std::ostream& operator<< (std::ostream& os, const Entry &entry)
 {
   os << "Prefix: " << *entry.m_prefix << "\n";
@@ -34,6 +34,7 @@
 
 #include "ns3/ndn-pit-entry-incoming-face.h"
 #include "ns3/ndn-pit-entry-outgoing-face.h"
+#include "ns3/memory-usage.h"
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -48,6 +49,7 @@ namespace ns3 {
 namespace ndn {
 
 class Pit;
+class ForwardingStrategy;
 
 namespace pit {
 
@@ -243,6 +245,18 @@ public:
   virtual void
   SetFibEntry (const Ptr<fib::Entry> &fibEntry) ;
 
+  /**
+   * @brief Get forwarding strategy that is responsible for the entry (0, if not yet assigned)
+   */
+  Ptr<ForwardingStrategy>
+  GetStrategy () const;
+
+  /**
+   * @brief Set forwarding strategy that is responsible for the entry
+   */
+  void
+  SetStrategy (Ptr<ForwardingStrategy> strategy);
+
   const in_container &
   GetIncoming () const { return m_incoming; }
 
@@ -252,6 +266,14 @@ public:
   uint32_t
   GetMaxRetxCount () const { return m_maxRetxCount; }
 
+  /**
+   * @brief Get memory used by nonce and face containers and by the prefix of the entry
+   *
+   * Size of the entry object itself is not included, it is accounted by the PIT implementation
+   */
+  MemoryUsage
+  GetMemoryUsage () const;
+
 private:
   friend std::ostream& operator<< (std::ostream& os, const Entry &entry);
   
@@ -260,6 +282,7 @@ protected:
   
   Ptr<const NameComponents> m_prefix; ///< \brief Prefix of the PIT entry
   Ptr<fib::Entry> m_fibEntry;     ///< \brief FIB entry related to this prefix
+  ForwardingStrategy *m_strategy; ///< \brief Strategy that created the entry (not Ptr to avoid strategy->PIT->entry->strategy cycle)
   
   nonce_container m_seenNonces;  ///< \brief map of nonces that were seen for this prefix  
   in_container  m_incoming;      ///< \brief container for incoming interests
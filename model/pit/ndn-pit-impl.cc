@@ -28,6 +28,7 @@
 #include "../../utils/persistent-policy.h"
 #include "../../utils/random-policy.h"
 #include "../../utils/lru-policy.h"
+#include "../../utils/stage-profiler.h"
 
 #include "ns3/log.h"
 #include "ns3/string.h"
@@ -151,6 +152,10 @@ PitImpl<Policy>::NotifyNewAggregate ()
     {
       m_forwardingStrategy = GetObject<ForwardingStrategy> ();
     }
+  if (m_profiler == 0)
+    {
+      m_profiler = GetObject<StageProfiler> ();
+    }
 
   Pit::NotifyNewAggregate ();
 }
@@ -163,6 +168,7 @@ PitImpl<Policy>::DoDispose ()
 
   m_forwardingStrategy = 0;
   m_fib = 0;
+  m_profiler = 0;
 
   Pit::DoDispose ();
 }
@@ -257,7 +263,11 @@ PitImpl<Policy>::Create (Ptr<const InterestHeader> header)
   
   if(header->IsEnabledLocator () && header->GetLocator().size()>0)
     {
-      Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatchOfLocator (*header);
+      Ptr<fib::Entry> fibEntry;
+      {
+        NDN_PROFILE_STAGE (m_profiler, FIB);
+        fibEntry = m_fib->LongestPrefixMatchOfLocator (*header);
+      }
 	if (fibEntry == 0)
         return 0;
 	
@@ -282,7 +292,11 @@ PitImpl<Policy>::Create (Ptr<const InterestHeader> header)
   }
   else
   {
-      Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
+      Ptr<fib::Entry> fibEntry;
+      {
+        NDN_PROFILE_STAGE (m_profiler, FIB);
+        fibEntry = m_fib->LongestPrefixMatch (*header);
+      }
 	if (fibEntry == 0)
         return 0;
 	
@@ -337,6 +351,24 @@ PitImpl<Policy>::GetSize () const
   return super::getPolicy ().size ();
 }
 
+template<class Policy>
+MemoryUsage
+PitImpl<Policy>::GetMemoryUsage () const
+{
+  MemoryUsage usage;
+  usage.m_index += super::getTrie ().memory_usage ();
+
+  typename super::parent_trie::const_recursive_iterator item (super::getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      usage.m_entries += sizeof (entry);
+      usage += item->payload ()->GetMemoryUsage ();
+    }
+  return usage;
+}
+
 template<class Policy>
 Ptr<Entry>
 PitImpl<Policy>::Begin ()
@@ -33,6 +33,7 @@ namespace ns3 {
 namespace ndn {
 
 class ForwardingStrategy;
+class StageProfiler;
 
 namespace pit {
 
@@ -92,6 +93,9 @@ public:
   virtual uint32_t
   GetSize () const;
 
+  virtual MemoryUsage
+  GetMemoryUsage () const;
+
   virtual Ptr<Entry>
   Begin ();
 
@@ -120,6 +124,7 @@ private:
   EventId m_cleanEvent;
   Ptr<Fib> m_fib; ///< \brief Link to FIB table
   Ptr<ForwardingStrategy> m_forwardingStrategy;
+  Ptr<StageProfiler> m_profiler; ///< \brief Optional profiler of forwarding stages (see NDN_PROFILE_STAGE)
 
   // indexes
   typedef
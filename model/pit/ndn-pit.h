@@ -120,6 +120,12 @@ public:
   virtual uint32_t
   GetSize () const = 0;
 
+  /**
+   * @brief Get estimate of memory used by the PIT (index, entries, and names)
+   */
+  virtual MemoryUsage
+  GetMemoryUsage () const = 0;
+
   /**
    * @brief Return first element of FIB (no order guaranteed)
    */
@@ -0,0 +1,304 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-cache-policies.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndn-name-components.h"
+#include "ns3/ndn-content-store.h"
+
+#include "../utils/trie-with-policy.h"
+#include "../utils/arc-policy.h"
+#include "../utils/slru-policy.h"
+#include "../utils/tinylfu-policy.h"
+
+#include <boost/tuple/tuple.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.CachePoliciesTest");
+
+namespace ns3
+{
+
+using namespace ndn;
+using namespace ndn::ndnSIM;
+
+namespace
+{
+
+struct Payload : public SimpleRefCount<Payload>
+{
+};
+
+template<class Policy>
+struct cache
+{
+  typedef trie_with_policy<NameComponents, smart_pointer_payload_traits<Payload>, Policy> type;
+};
+
+NameComponents
+MakeName (const std::string &prefix, uint32_t seq)
+{
+  NameComponents name;
+  name (prefix) (seq);
+  return name;
+}
+
+/**
+ * Check if the name is cached without notifying the policy (unlike find_exact)
+ */
+template<class Cache>
+bool
+IsCached (Cache &store, const NameComponents &name)
+{
+  typename Cache::iterator foundItem, lastItem;
+  bool reachLast;
+  boost::tie (foundItem, reachLast, lastItem) = store.getTrie ().find (name);
+
+  return reachLast && lastItem->payload () != 0;
+}
+
+/**
+ * Number of entries in the trie, to compare with the size reported by the policy
+ */
+template<class Cache>
+size_t
+CountCached (Cache &store)
+{
+  size_t count = 0;
+  typename Cache::parent_trie::recursive_iterator item (store.getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () != 0)
+        count++;
+    }
+  return count;
+}
+
+/**
+ * Lookup the name and insert it on miss, as a content store would
+ */
+template<class Cache>
+bool
+Request (Cache &store, const NameComponents &name)
+{
+  if (store.find_exact (name) != store.end ())
+    return true;
+
+  store.insert (name, Create<Payload> ());
+  return false;
+}
+
+}
+
+void
+CachePoliciesTest::DoRun ()
+{
+  SlruTests ();
+  ArcTests ();
+  TinyLfuTests ();
+
+  SizeBoundTest<arc_policy_traits> ("ARC");
+  SizeBoundTest<slru_policy_traits> ("SLRU");
+  SizeBoundTest<tinylfu_policy_traits> ("TinyLFU");
+
+  ContentStoreTest ("ns3::ndn::cs::Arc");
+  ContentStoreTest ("ns3::ndn::cs::Slru");
+  ContentStoreTest ("ns3::ndn::cs::TinyLfu");
+}
+
+void
+CachePoliciesTest::SlruTests ()
+{
+  // promotion on hit and scan resistance
+  cache<slru_policy_traits>::type slru;
+  slru.getPolicy ().set_max_size (10);
+
+  for (uint32_t i = 0; i < 10; i++)
+    slru.insert (MakeName ("slru", i), Create<Payload> ());
+
+  NS_TEST_ASSERT_MSG_EQ (Request (slru, MakeName ("slru", 0)), true, "/slru/0 should be cached");
+  NS_TEST_ASSERT_MSG_EQ (Request (slru, MakeName ("slru", 1)), true, "/slru/1 should be cached");
+
+  for (uint32_t i = 0; i < 50; i++)
+    Request (slru, MakeName ("scan", i));
+
+  NS_TEST_ASSERT_MSG_EQ (IsCached (slru, MakeName ("slru", 0)), true, "Protected entry should survive the scan");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (slru, MakeName ("slru", 1)), true, "Protected entry should survive the scan");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (slru, MakeName ("slru", 2)), false, "Probationary entry should be evicted by the scan");
+  NS_TEST_ASSERT_MSG_EQ (slru.getPolicy ().size (), 10, "Cache should be full");
+  NS_TEST_ASSERT_MSG_EQ (CountCached (slru), 10, "Policy and trie sizes should match");
+
+  // protected segment is limited to 80%, least recently used protected entries go back to probation
+  slru.clear ();
+  for (uint32_t i = 0; i < 10; i++)
+    slru.insert (MakeName ("slru", i), Create<Payload> ());
+  for (uint32_t i = 0; i < 10; i++)
+    Request (slru, MakeName ("slru", i));
+
+  Request (slru, MakeName ("new", 0));
+  Request (slru, MakeName ("new", 1));
+
+  NS_TEST_ASSERT_MSG_EQ (IsCached (slru, MakeName ("slru", 0)), false, "Demoted entry should be evicted first");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (slru, MakeName ("slru", 1)), false, "Demoted entry should be evicted first");
+  for (uint32_t i = 2; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (IsCached (slru, MakeName ("slru", i)), true, "Protected entry should not be evicted");
+    }
+  NS_TEST_ASSERT_MSG_EQ (slru.getPolicy ().size (), 10, "Cache should be full");
+}
+
+void
+CachePoliciesTest::ArcTests ()
+{
+  // entries seen twice (T2) survive a scan of one-time requests
+  cache<arc_policy_traits>::type arc;
+  arc.getPolicy ().set_max_size (10);
+
+  for (uint32_t i = 0; i < 10; i++)
+    arc.insert (MakeName ("arc", i), Create<Payload> ());
+  for (uint32_t i = 0; i < 5; i++)
+    Request (arc, MakeName ("arc", i));
+
+  for (uint32_t i = 0; i < 50; i++)
+    Request (arc, MakeName ("scan", i));
+
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (IsCached (arc, MakeName ("arc", i)), true, "Frequent entry should survive the scan");
+    }
+  for (uint32_t i = 5; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (IsCached (arc, MakeName ("arc", i)), false, "Recent entry should be evicted by the scan");
+    }
+  NS_TEST_ASSERT_MSG_EQ (arc.getPolicy ().size (), 10, "Cache should be full");
+  NS_TEST_ASSERT_MSG_EQ (CountCached (arc), 10, "Policy and trie sizes should match");
+
+  // entry that is requested again shortly after eviction (hit in B1) goes directly to T2
+  arc.clear ();
+  arc.getPolicy ().set_max_size (4);
+  for (uint32_t i = 0; i < 4; i++)
+    arc.insert (MakeName ("arc", i), Create<Payload> ());
+  Request (arc, MakeName ("arc", 3));
+  Request (arc, MakeName ("arc", 4)); // evicts /arc/0
+
+  NS_TEST_ASSERT_MSG_EQ (IsCached (arc, MakeName ("arc", 0)), false, "/arc/0 should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (Request (arc, MakeName ("arc", 0)), false, "/arc/0 should be a miss");
+
+  for (uint32_t i = 0; i < 20; i++)
+    Request (arc, MakeName ("scan", i));
+
+  NS_TEST_ASSERT_MSG_EQ (IsCached (arc, MakeName ("arc", 0)), true, "Entry returned from the ghost list should survive the scan");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (arc, MakeName ("arc", 3)), true, "Frequent entry should survive the scan");
+  NS_TEST_ASSERT_MSG_EQ (arc.getPolicy ().size (), 4, "Cache should be full");
+}
+
+void
+CachePoliciesTest::TinyLfuTests ()
+{
+  cache<tinylfu_policy_traits>::type lfu;
+  lfu.getPolicy ().set_max_size (10);
+
+  for (uint32_t i = 0; i < 10; i++)
+    lfu.insert (MakeName ("lfu", i), Create<Payload> ());
+  for (uint32_t hit = 0; hit < 3; hit++)
+    for (uint32_t i = 0; i < 10; i++)
+      Request (lfu, MakeName ("lfu", i));
+
+  // one-hit items are not admitted into the full cache
+  uint32_t admitted = 0;
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      if (lfu.insert (MakeName ("scan", i), Create<Payload> ()).second)
+        admitted++;
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (admitted, 0, "One-hit items should be rejected");
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (IsCached (lfu, MakeName ("lfu", i)), true, "Popular entry should not be evicted");
+    }
+  NS_TEST_ASSERT_MSG_EQ (lfu.getPolicy ().size (), 10, "Cache should be full");
+  NS_TEST_ASSERT_MSG_EQ (CountCached (lfu), 10, "Rejected items should not stay in the trie");
+
+  // item that is requested more often than the victim is eventually admitted
+  bool hotAdmitted = false;
+  for (uint32_t attempt = 0; attempt < 10 && !hotAdmitted; attempt++)
+    hotAdmitted = lfu.insert (MakeName ("hot", 0), Create<Payload> ()).second;
+
+  NS_TEST_ASSERT_MSG_EQ (hotAdmitted, true, "Frequently requested item should be admitted");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (lfu, MakeName ("hot", 0)), true, "Admitted item should be cached");
+  NS_TEST_ASSERT_MSG_EQ (lfu.getPolicy ().size (), 10, "Admission should evict the victim");
+  NS_TEST_ASSERT_MSG_EQ (CountCached (lfu), 10, "Policy and trie sizes should match");
+}
+
+template<class Policy>
+void
+CachePoliciesTest::SizeBoundTest (const std::string &policyName)
+{
+  typename cache<Policy>::type store;
+  store.getPolicy ().set_max_size (20);
+
+  // skewed mix of repeated and new names
+  size_t maxSize = 0;
+  uint32_t state = 1;
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      state = state * 1103515245 + 12345;
+      uint32_t seq = (state >> 16) % 100;
+      if (seq >= 50)
+        seq = (seq * seq) % 100;
+
+      Request (store, MakeName ("bound", seq));
+      maxSize = std::max (maxSize, store.getPolicy ().size ());
+    }
+
+  NS_TEST_ASSERT_MSG_LT (maxSize, 21, policyName << " should never exceed max size");
+  NS_TEST_ASSERT_MSG_EQ (CountCached (store), store.getPolicy ().size (), policyName << " policy and trie sizes should match");
+}
+
+void
+CachePoliciesTest::ContentStoreTest (const std::string &contentStore)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (contentStore);
+  factory.Set ("MaxSize", StringValue ("10"));
+  Ptr<ContentStore> cs = factory.Create<ContentStore> ();
+
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
+      header->SetName (Create<NameComponents> (MakeName ("cs", i)));
+      cs->Add (header, Create<Packet> (100));
+    }
+
+  Ptr<InterestHeader> interest = Create<InterestHeader> ();
+  interest->SetName (Create<NameComponents> (MakeName ("cs", 0)));
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (interest).get<0> (), 0, contentStore << ": /cs/0 should be cached");
+
+  for (uint32_t i = 0; i < 40; i++)
+    {
+      Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
+      header->SetName (Create<NameComponents> (MakeName ("scan", i)));
+      cs->Add (header, Create<Packet> (100));
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (cs->GetSize (), 10, contentStore << " should be full");
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (interest).get<0> (), 0, contentStore << ": /cs/0 should survive the scan");
+}
+
+}
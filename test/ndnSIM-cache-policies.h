@@ -0,0 +1,60 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_TEST_CACHE_POLICIES_H
+#define NDNSIM_TEST_CACHE_POLICIES_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+#include <string>
+
+namespace ns3
+{
+
+class CachePoliciesTest : public TestCase
+{
+public:
+  CachePoliciesTest ()
+    : TestCase ("ARC, SLRU, and TinyLFU cache policies test")
+  {
+  }
+    
+private:
+  virtual void DoRun ();
+
+  void
+  SlruTests ();
+
+  void
+  ArcTests ();
+
+  void
+  TinyLfuTests ();
+
+  template<class Policy>
+  void
+  SizeBoundTest (const std::string &policyName);
+
+  void
+  ContentStoreTest (const std::string &contentStore);
+};
+  
+}
+
+#endif // NDNSIM_TEST_CACHE_POLICIES_H
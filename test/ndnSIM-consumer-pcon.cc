@@ -0,0 +1,80 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-consumer-pcon.h"
+#include "ns3/core-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerPconTest");
+
+namespace ns3 {
+
+using namespace ndn;
+
+void
+ConsumerPconTest::DoRun ()
+{
+  DefaultSizeSendsInterests ();
+}
+
+void
+ConsumerPconTest::OnInterest (Ptr<const InterestHeader> interest, Ptr<App> app, Ptr<Face> face)
+{
+  m_interests++;
+}
+
+void
+ConsumerPconTest::DefaultSizeSendsInterests ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  StackHelper ndn;
+  ndn.SetDefaultRoutes (true);
+  ndn.InstallAll ();
+
+  // Size attribute is not set: there should be no limit on the amount of data to request
+  AppHelper consumerHelper ("ns3::ndn::ConsumerPcon");
+  consumerHelper.SetPrefix ("/prefix");
+  ApplicationContainer consumer = consumerHelper.Install (nodes.Get (0));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.Install (nodes.Get (1));
+
+  DoubleValue size;
+  consumer.Get (0)->GetAttribute ("Size", size);
+  NS_TEST_ASSERT_MSG_EQ (size.Get (), -1.0, "Size should be reported as unlimited");
+
+  m_interests = 0;
+  consumer.Get (0)->TraceConnectWithoutContext ("TransmittedInterests",
+                                                MakeCallback (&ConsumerPconTest::OnInterest, this));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_GT (m_interests, 10, "ConsumerPcon with default attributes should keep requesting data");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,182 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-global-routing.h"
+#include "ns3/core-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingTest");
+
+namespace ns3 {
+
+using namespace ndn;
+
+void
+GlobalRoutingTest::DoRun ()
+{
+  MultipathNextHops ();
+  IncrementalUpdate ();
+}
+
+static Ptr<fib::Entry>
+FindRoutes (Ptr<Node> node, const std::string &prefix)
+{
+  InterestHeader interest;
+  interest.SetName (Create<NameComponents> (prefix));
+  return node->GetObject<Fib> ()->LongestPrefixMatch (interest);
+}
+
+static Ptr<Face>
+GetFace (Ptr<NetDevice> device)
+{
+  return device->GetNode ()->GetObject<L3Protocol> ()->GetFaceByNetDevice (device);
+}
+
+uint32_t
+GlobalRoutingTest::CountRoutes (Ptr<Node> node, const std::string &prefix)
+{
+  Ptr<fib::Entry> entry = FindRoutes (node, prefix);
+  if (entry == 0)
+    return 0;
+
+  uint32_t count = 0;
+  for (fib::FaceMetricContainer::type::iterator metric = entry->m_faces.begin ();
+       metric != entry->m_faces.end ();
+       metric++)
+    {
+      if (metric->m_status != fib::FaceMetric::NDN_FIB_RED)
+        count++;
+    }
+  return count;
+}
+
+void
+GlobalRoutingTest::CheckRoute (Ptr<Node> node, const std::string &prefix, Ptr<Face> face, int32_t cost)
+{
+  Ptr<fib::Entry> entry = FindRoutes (node, prefix);
+  NS_TEST_ASSERT_MSG_NE (entry, 0, "Node " << node->GetId () << " should have a route to " << prefix);
+
+  fib::FaceMetricContainer::type::index<fib::i_face>::type::iterator metric = entry->m_faces.get<fib::i_face> ().find (face);
+  NS_TEST_ASSERT_MSG_EQ ((metric != entry->m_faces.get<fib::i_face> ().end ()), true,
+                         "Node " << node->GetId () << " should route " << prefix << " via " << *face);
+  NS_TEST_ASSERT_MSG_EQ (metric->m_status != fib::FaceMetric::NDN_FIB_RED, true,
+                         "Route to " << prefix << " via " << *face << " should be valid");
+  NS_TEST_ASSERT_MSG_EQ (metric->m_routingCost, cost,
+                         "Route to " << prefix << " via " << *face << " has wrong cost");
+}
+
+void
+GlobalRoutingTest::MultipathNextHops ()
+{
+  // 0-1-3 and 0-2-3 are equal-cost paths, 0-4 and 4-3 (metric 5) are additional links
+  NodeContainer nodes;
+  nodes.Create (5);
+
+  PointToPointHelper p2p;
+  NetDeviceContainer link01 = p2p.Install (nodes.Get (0), nodes.Get (1));
+  NetDeviceContainer link02 = p2p.Install (nodes.Get (0), nodes.Get (2));
+  p2p.Install (nodes.Get (1), nodes.Get (3));
+  p2p.Install (nodes.Get (2), nodes.Get (3));
+  NetDeviceContainer link04 = p2p.Install (nodes.Get (0), nodes.Get (4));
+  NetDeviceContainer link43 = p2p.Install (nodes.Get (4), nodes.Get (3));
+
+  StackHelper ndn;
+  ndn.InstallAll ();
+
+  GetFace (link43.Get (0))->SetMetric (5);
+  GetFace (link43.Get (1))->SetMetric (5);
+
+  GlobalRoutingHelper routing;
+  routing.InstallAll ();
+  routing.AddOrigin ("/d", nodes.Get (3));
+
+  routing.CalculateMultipathRoutes (3);
+
+  // both equal-cost paths, but not the path via 4 (4 is farther from 3 than 0 is)
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (0), "/d"), 2, "Node 0 should have two next hops");
+  CheckRoute (nodes.Get (0), "/d", GetFace (link01.Get (0)), 2);
+  CheckRoute (nodes.Get (0), "/d", GetFace (link02.Get (0)), 2);
+
+  // shortest path via 0 and the direct (downstream) link
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (4), "/d"), 2, "Node 4 should have two next hops");
+  CheckRoute (nodes.Get (4), "/d", GetFace (link04.Get (1)), 3);
+  CheckRoute (nodes.Get (4), "/d", GetFace (link43.Get (0)), 5);
+
+  // going back via 0 could loop
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (1), "/d"), 1, "Node 1 should have one next hop");
+
+  routing.CalculateMultipathRoutes (1);
+
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (0), "/d"), 1, "Node 0 should have one next hop");
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (4), "/d"), 1, "Node 4 should have one next hop");
+  CheckRoute (nodes.Get (4), "/d", GetFace (link04.Get (1)), 3);
+
+  Simulator::Destroy ();
+}
+
+
+void
+GlobalRoutingTest::IncrementalUpdate ()
+{
+  // 0-1-3 is the shortest path, 0-2-3 (0-2 has metric 2) is the backup
+  NodeContainer nodes;
+  nodes.Create (4);
+
+  PointToPointHelper p2p;
+  NetDeviceContainer link01 = p2p.Install (nodes.Get (0), nodes.Get (1));
+  NetDeviceContainer link02 = p2p.Install (nodes.Get (0), nodes.Get (2));
+  NetDeviceContainer link13 = p2p.Install (nodes.Get (1), nodes.Get (3));
+  p2p.Install (nodes.Get (2), nodes.Get (3));
+
+  StackHelper ndn;
+  ndn.InstallAll ();
+
+  GetFace (link02.Get (0))->SetMetric (2);
+  GetFace (link02.Get (1))->SetMetric (2);
+
+  GlobalRoutingHelper routing;
+  routing.InstallAll ();
+  routing.AddOrigin ("/d", nodes.Get (3));
+  routing.CalculateRoutes (true);
+
+  CheckRoute (nodes.Get (0), "/d", GetFace (link01.Get (0)), 2);
+  CheckRoute (nodes.Get (1), "/d", GetFace (link13.Get (0)), 1);
+
+  // faces that are down get the infinite weight and are never part of a path
+  GetFace (link13.Get (0))->SetUp (false);
+  GetFace (link13.Get (1))->SetUp (false);
+  routing.UpdateRoutes (link13.Get (0)->GetChannel ());
+
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (0), "/d"), 1, "Route of node 0 via 1 should be invalidated");
+  CheckRoute (nodes.Get (0), "/d", GetFace (link02.Get (0)), 3);
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (1), "/d"), 1, "Route of node 1 via the failed link should be invalidated");
+  CheckRoute (nodes.Get (1), "/d", GetFace (link01.Get (1)), 4);
+
+  GetFace (link13.Get (0))->SetUp (true);
+  GetFace (link13.Get (1))->SetUp (true);
+  routing.UpdateRoutes (link13.Get (0)->GetChannel ());
+
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (0), "/d"), 1, "Backup route of node 0 should be invalidated");
+  CheckRoute (nodes.Get (0), "/d", GetFace (link01.Get (0)), 2);
+  NS_TEST_ASSERT_MSG_EQ (CountRoutes (nodes.Get (1), "/d"), 1, "Route of node 1 via 0 should be invalidated");
+  CheckRoute (nodes.Get (1), "/d", GetFace (link13.Get (0)), 1);
+
+  Simulator::Destroy ();
+}
+
+}
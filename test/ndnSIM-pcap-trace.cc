@@ -0,0 +1,130 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-pcap-trace.h"
+#include "ns3/core-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+#include <cstdio>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PcapTraceTest");
+
+namespace ns3 {
+
+using namespace ndn;
+
+void
+PcapTraceTest::OnData (Ptr<const ContentObjectHeader> data, Ptr<const Packet> payload,
+                       Ptr<App> app, Ptr<Face> face)
+{
+  m_data++;
+}
+
+template<class T>
+static T
+Read (std::istream &is)
+{
+  T value = 0;
+  is.read (reinterpret_cast<char*> (&value), sizeof (T));
+  return value;
+}
+
+void
+PcapTraceTest::DoRun ()
+{
+  const std::string file = "ndnSIM-pcap-trace-test.pcap";
+  const uint32_t snapLen = 64;
+  const uint32_t payloadSize = 1024;
+
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  StackHelper ndn;
+  ndn.SetDefaultRoutes (true);
+  ndn.InstallAll ();
+
+  AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("100"));
+  ApplicationContainer consumer = consumerHelper.Install (nodes.Get (0));
+  consumer.Stop (Seconds (1.0));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.SetAttribute ("PayloadSize", UintegerValue (payloadSize));
+  producerHelper.Install (nodes.Get (1));
+
+  m_data = 0;
+  consumer.Get (0)->TraceConnectWithoutContext ("ReceivedContentObjects",
+                                                MakeCallback (&PcapTraceTest::OnData, this));
+
+  // small blocks, so records are handed over to the writer thread many times during the run
+  PcapTraceHelper pcap (snapLen, 4096);
+  pcap.EnableMerged (file, NodeContainer (nodes.Get (0)), PcapTraceHelper::RX); // only Data is received by node 0
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+
+  pcap.Close ();
+  NS_TEST_ASSERT_MSG_GT (m_data, 0, "Consumer should receive Data");
+  NS_TEST_ASSERT_MSG_EQ (pcap.GetWriter ()->GetRecordCount (), m_data, "Every received Data should be captured");
+
+  std::ifstream is (file.c_str (), std::ios::in | std::ios::binary);
+  NS_TEST_ASSERT_MSG_EQ (is.is_open (), true, "Cannot open " << file);
+
+  NS_TEST_ASSERT_MSG_EQ (Read<uint32_t> (is), 0xa1b2c3d4, "Wrong magic number");
+  NS_TEST_ASSERT_MSG_EQ (Read<uint16_t> (is), 2, "Wrong major version");
+  NS_TEST_ASSERT_MSG_EQ (Read<uint16_t> (is), 4, "Wrong minor version");
+  NS_TEST_ASSERT_MSG_EQ (Read<int32_t> (is), 0, "Wrong time zone");
+  NS_TEST_ASSERT_MSG_EQ (Read<uint32_t> (is), 0, "Wrong timestamp accuracy");
+  NS_TEST_ASSERT_MSG_EQ (Read<uint32_t> (is), snapLen, "Wrong snapLen");
+  NS_TEST_ASSERT_MSG_EQ (Read<uint32_t> (is), 9, "Wrong data link type");
+
+  uint32_t records = 0;
+  uint64_t lastTime = 0;
+  while (is.peek () != std::ifstream::traits_type::eof ())
+    {
+      uint64_t seconds = Read<uint32_t> (is);
+      uint64_t time = seconds * 1000000 + Read<uint32_t> (is);
+      uint32_t inclLen = Read<uint32_t> (is);
+      uint32_t origLen = Read<uint32_t> (is);
+      NS_TEST_ASSERT_MSG_EQ (is.good (), true, "Truncated record header");
+
+      NS_TEST_ASSERT_MSG_EQ ((time >= lastTime), true, "Records should be ordered by time");
+      NS_TEST_ASSERT_MSG_GT (origLen, payloadSize, "Original length should be the size of the whole Data packet");
+      NS_TEST_ASSERT_MSG_EQ (inclLen, snapLen, "Records longer than snapLen should be truncated");
+
+      is.seekg (inclLen, std::ios::cur);
+      NS_TEST_ASSERT_MSG_EQ (is.good (), true, "Truncated record data");
+
+      lastTime = time;
+      records++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (records, m_data, "Wrong number of records in " << file);
+
+  is.close ();
+  std::remove (file.c_str ());
+
+  Simulator::Destroy ();
+}
+
+}
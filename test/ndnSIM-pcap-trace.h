@@ -0,0 +1,55 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef NDNSIM_TEST_PCAP_TRACE_H
+#define NDNSIM_TEST_PCAP_TRACE_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Packet;
+
+namespace ndn {
+class ContentObjectHeader;
+class App;
+class Face;
+}
+
+class PcapTraceTest : public TestCase
+{
+public:
+  PcapTraceTest ()
+    : TestCase ("PcapTraceHelper test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  OnData (Ptr<const ndn::ContentObjectHeader> data, Ptr<const Packet> payload,
+          Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+private:
+  uint32_t m_data;
+};
+
+}
+
+#endif // NDNSIM_TEST_PCAP_TRACE_H
@@ -99,24 +99,24 @@ StatsTreeTest::BasicTests ()
   NS_TEST_ASSERT_MSG_EQ (node.incoming ().size (), 2, "Incoming should have two entries again");
   NS_TEST_ASSERT_MSG_EQ (node.outgoing ().size (), 0, "Outgoing should have 0 entries");
 
-  // NS_LOG_DEBUG ("count:      " << node.incoming ().find (face1)->second.count ());
-  // NS_LOG_DEBUG ("satisfied:  " << node.incoming ().find (face1)->second.satisfied ());
-  // NS_LOG_DEBUG ("unsatisfied:" << node.incoming ().find (face1)->second.unsatisfied ());
+  // NS_LOG_DEBUG ("count:      " << node.incoming ().find (face1)->count ());
+  // NS_LOG_DEBUG ("satisfied:  " << node.incoming ().find (face1)->satisfied ());
+  // NS_LOG_DEBUG ("unsatisfied:" << node.incoming ().find (face1)->unsatisfied ());
 
   node.Step ();
   
-  // NS_LOG_DEBUG ("count:      " << node.incoming ().find (face1)->second.count ());
-  // NS_LOG_DEBUG ("satisfied:  " << node.incoming ().find (face1)->second.satisfied ());
-  // NS_LOG_DEBUG ("unsatisfied:" << node.incoming ().find (face1)->second.unsatisfied ());
+  // NS_LOG_DEBUG ("count:      " << node.incoming ().find (face1)->count ());
+  // NS_LOG_DEBUG ("satisfied:  " << node.incoming ().find (face1)->satisfied ());
+  // NS_LOG_DEBUG ("unsatisfied:" << node.incoming ().find (face1)->unsatisfied ());
   
-  LoadStats::stats_tuple tuple = node.incoming ().find (face1)->second.GetSatisfiedRatio ();
+  LoadStats::stats_tuple tuple = node.incoming ().find (face1)->GetSatisfiedRatio ();
   // NS_LOG_DEBUG ("In, face1, satisfied ratio: " << tuple.get<0> () << ", " << tuple.get<1> () << ", " << tuple.get<2> ());
 
   NS_TEST_ASSERT_MSG_EQ_TOL (tuple.get<0> (), 0.667, 0.01, "Satisfied ratio should be ~ 2/3");
   NS_TEST_ASSERT_MSG_LT     (tuple.get<1> (), 0,           "Satisfied ratio should be less 0 (invalid)");
   NS_TEST_ASSERT_MSG_LT     (tuple.get<2> (), 0,           "Satisfied ratio should be less 0 (invalid)");
   
-  tuple = node.incoming ().find (face1)->second.GetUnsatisfiedRatio ();
+  tuple = node.incoming ().find (face1)->GetUnsatisfiedRatio ();
   // NS_LOG_DEBUG ("In, face1, unsatisfied ratio: " << tuple.get<0> () << ", " << tuple.get<1> () << ", " << tuple.get<2> ());
 
   NS_TEST_ASSERT_MSG_EQ_TOL (tuple.get<0> (), 0.333, 0.01, "Satisfied ratio should be ~ 1/3");
@@ -129,14 +129,14 @@ StatsTreeTest::BasicTests ()
 
   // NS_LOG_DEBUG ("After decaying");
   
-  tuple = node.incoming ().find (face1)->second.GetSatisfiedRatio ();
+  tuple = node.incoming ().find (face1)->GetSatisfiedRatio ();
   // NS_LOG_DEBUG ("In, face1, satisfied ratio: " << tuple.get<0> () << ", " << tuple.get<1> () << ", " << tuple.get<2> ());
 
   NS_TEST_ASSERT_MSG_EQ_TOL (tuple.get<0> (), 0.473776, 0.01, "");
   NS_TEST_ASSERT_MSG_EQ_TOL (tuple.get<1> (), 0.489, 0.01, "");
   NS_TEST_ASSERT_MSG_LT     (tuple.get<2> (), 0,           "");
   
-  tuple = node.incoming ().find (face1)->second.GetUnsatisfiedRatio ();
+  tuple = node.incoming ().find (face1)->GetUnsatisfiedRatio ();
   // NS_LOG_DEBUG ("In, face1, unsatisfied ratio: " << tuple.get<0> () << ", " << tuple.get<1> () << ", " << tuple.get<2> ());
 
   NS_TEST_ASSERT_MSG_EQ_TOL (tuple.get<0> (), 0.526, 0.01, "");
@@ -148,14 +148,14 @@ StatsTreeTest::BasicTests ()
 
   // NS_LOG_DEBUG ("After more decaying");
 
-  tuple = node.incoming ().find (face1)->second.GetSatisfiedRatio ();
+  tuple = node.incoming ().find (face1)->GetSatisfiedRatio ();
   // NS_LOG_DEBUG ("In, face1, satisfied ratio: " << tuple.get<0> () << ", " << tuple.get<1> () << ", " << tuple.get<2> ());
 
   NS_TEST_ASSERT_MSG_LT (tuple.get<0> (), 0, "");
   NS_TEST_ASSERT_MSG_LT (tuple.get<1> (), 0, "");
   NS_TEST_ASSERT_MSG_LT (tuple.get<2> (), 0, "");
   
-  tuple = node.incoming ().find (face1)->second.GetUnsatisfiedRatio ();
+  tuple = node.incoming ().find (face1)->GetUnsatisfiedRatio ();
   // NS_LOG_DEBUG ("In, face1, unsatisfied ratio: " << tuple.get<0> () << ", " << tuple.get<1> () << ", " << tuple.get<2> ());
 
   NS_TEST_ASSERT_MSG_LT (tuple.get<0> (), 0, "");
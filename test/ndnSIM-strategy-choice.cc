@@ -0,0 +1,166 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-strategy-choice.h"
+#include "ns3/core-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "../model/fw/strategy-choice.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.StrategyChoiceTest");
+
+namespace ns3 {
+
+using namespace ndn;
+
+void
+StrategyChoiceTest::DoRun ()
+{
+  ReplaceWithPendingInterests ();
+  PerPrefixDispatch ();
+}
+
+void
+StrategyChoiceTest::OnInterest (Ptr<const InterestHeader> interest, Ptr<App> app, Ptr<Face> face)
+{
+  m_interests++;
+}
+
+void
+StrategyChoiceTest::OnData (Ptr<const ContentObjectHeader> data, Ptr<const Packet> payload,
+                            Ptr<App> app, Ptr<Face> face)
+{
+  m_data++;
+}
+
+void
+StrategyChoiceTest::Replace (Ptr<Node> node)
+{
+  Ptr<Pit> pit = node->GetObject<Pit> ();
+  NS_TEST_ASSERT_MSG_GT (pit->GetSize (), 0, "There should be pending Interests when the strategy is replaced");
+
+  Ptr<ForwardingStrategy> strategy = StackHelper::SetPrefixStrategy (node, "/", "ns3::ndn::fw::BestRoute");
+  NS_TEST_ASSERT_MSG_EQ (node->GetObject<fw::StrategyChoice> ()->FindStrategy (NameComponents ("/prefix")), strategy,
+                         "Replacement strategy should be responsible for the prefix");
+
+  for (Ptr<pit::Entry> entry = pit->Begin (); entry != pit->End (); entry = pit->Next (entry))
+    {
+      NS_TEST_ASSERT_MSG_EQ (entry->GetStrategy (), strategy, "Pending Interests should be handed over to the new strategy");
+    }
+}
+
+void
+StrategyChoiceTest::ReplaceWithPendingInterests ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  StackHelper ndn;
+  ndn.SetForwardingStrategy ("ns3::ndn::fw::StrategyChoice");
+  ndn.SetDefaultRoutes (true);
+  ndn.InstallAll ();
+
+  AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("100"));
+  ApplicationContainer consumer = consumerHelper.Install (nodes.Get (0));
+  consumer.Stop (Seconds (1.0));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.Install (nodes.Get (1));
+
+  m_interests = 0;
+  m_data = 0;
+  consumer.Get (0)->TraceConnectWithoutContext ("TransmittedInterests",
+                                                MakeCallback (&StrategyChoiceTest::OnInterest, this));
+  consumer.Get (0)->TraceConnectWithoutContext ("ReceivedContentObjects",
+                                                MakeCallback (&StrategyChoiceTest::OnData, this));
+
+  // Interests sent during the last RTT are still pending
+  Simulator::Schedule (Seconds (0.5005), &StrategyChoiceTest::Replace, this, nodes.Get (0));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_GT (m_interests, 0, "Consumer should send Interests");
+  NS_TEST_ASSERT_MSG_EQ (m_data, m_interests, "All Interests should be satisfied, including those pending during replacement");
+
+  Simulator::Destroy ();
+}
+
+void
+StrategyChoiceTest::PerPrefixDispatch ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  StackHelper ndn;
+  ndn.SetForwardingStrategy ("ns3::ndn::fw::StrategyChoice");
+  ndn.SetDefaultRoutes (true);
+  ndn.InstallAll ();
+
+  Ptr<ForwardingStrategy> flooding = StackHelper::SetPrefixStrategy (nodes.Get (0), "/a", "ns3::ndn::fw::Flooding");
+  Ptr<ForwardingStrategy> bestRoute = StackHelper::SetPrefixStrategy (nodes.Get (0), "/b", "ns3::ndn::fw::BestRoute");
+
+  Ptr<fw::StrategyChoice> choice = nodes.Get (0)->GetObject<fw::StrategyChoice> ();
+  Ptr<ForwardingStrategy> defaultStrategy = choice->FindStrategy (NameComponents ("/"));
+  NS_TEST_ASSERT_MSG_EQ (choice->FindStrategy (NameComponents ("/a/1")), flooding, "/a should be dispatched to Flooding");
+  NS_TEST_ASSERT_MSG_EQ (choice->FindStrategy (NameComponents ("/b/1")), bestRoute, "/b should be dispatched to BestRoute");
+  NS_TEST_ASSERT_MSG_EQ (choice->FindStrategy (NameComponents ("/c/1")), defaultStrategy, "/c should be dispatched to the default strategy");
+
+  AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10"));
+  consumerHelper.SetPrefix ("/a");
+  consumerHelper.Install (nodes.Get (0)).Stop (Seconds (1.0));
+  consumerHelper.SetPrefix ("/b");
+  consumerHelper.Install (nodes.Get (0)).Stop (Seconds (1.0));
+
+  AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/");
+  producerHelper.Install (nodes.Get (1));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_GT (flooding->GetTraceCount ("OutInterests"), 0, "Flooding should forward Interests for /a");
+  NS_TEST_ASSERT_MSG_GT (bestRoute->GetTraceCount ("OutInterests"), 0, "BestRoute should forward Interests for /b");
+  NS_TEST_ASSERT_MSG_EQ (defaultStrategy->GetTraceCount ("OutInterests"), 0, "Default strategy should not see Interests for /a and /b");
+
+  // traces of the strategies are mirrored by StrategyChoice, even though nothing is connected to them
+  NS_TEST_ASSERT_MSG_EQ (choice->GetTraceCount ("OutInterests"),
+                         flooding->GetTraceCount ("OutInterests") + bestRoute->GetTraceCount ("OutInterests"),
+                         "StrategyChoice should mirror OutInterests of all strategies");
+  NS_TEST_ASSERT_MSG_EQ (choice->GetTraceCount ("InData"),
+                         flooding->GetTraceCount ("InData") + bestRoute->GetTraceCount ("InData"),
+                         "StrategyChoice should mirror InData of all strategies");
+  NS_TEST_ASSERT_MSG_EQ (choice->GetTraceCount ("InNacks"),
+                         flooding->GetTraceCount ("InNacks") + bestRoute->GetTraceCount ("InNacks"),
+                         "StrategyChoice should mirror InNacks of strategies derived from Nacks");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,71 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_TEST_STRATEGY_CHOICE_H
+#define NDNSIM_TEST_STRATEGY_CHOICE_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Node;
+class Packet;
+
+namespace ndn {
+class ContentObjectHeader;
+class InterestHeader;
+class App;
+class Face;
+}
+
+class StrategyChoiceTest : public TestCase
+{
+public:
+  StrategyChoiceTest ()
+    : TestCase ("StrategyChoice test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  ReplaceWithPendingInterests ();
+
+  void
+  PerPrefixDispatch ();
+
+  void
+  Replace (Ptr<Node> node);
+
+  void
+  OnInterest (Ptr<const ndn::InterestHeader> interest, Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+  void
+  OnData (Ptr<const ndn::ContentObjectHeader> data, Ptr<const Packet> payload,
+          Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+private:
+  uint32_t m_interests;
+  uint32_t m_data;
+};
+
+}
+
+#endif // NDNSIM_TEST_STRATEGY_CHOICE_H
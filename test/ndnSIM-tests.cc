@@ -24,6 +24,11 @@
 #include "ndnSIM-serialization.h"
 #include "ndnSIM-pit.h"
 #include "ndnSIM-stats-tree.h"
+#include "ndnSIM-cache-policies.h"
+#include "ndnSIM-consumer-pcon.h"
+#include "ndnSIM-strategy-choice.h"
+#include "ndnSIM-global-routing.h"
+#include "ndnSIM-pcap-trace.h"
 
 namespace ns3
 {
@@ -40,6 +45,11 @@ public:
     AddTestCase (new ContentObjectSerializationTest ());
     AddTestCase (new PitTest ());
     AddTestCase (new StatsTreeTest ());
+    AddTestCase (new CachePoliciesTest ());
+    AddTestCase (new ConsumerPconTest ());
+    AddTestCase (new StrategyChoiceTest ());
+    AddTestCase (new GlobalRoutingTest ());
+    AddTestCase (new PcapTraceTest ());
   }
 };
 
@@ -0,0 +1,573 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// ndn-microbenchmark: throughput of trie, PIT, content store, and CCNB codec hot paths
+//
+// Every benchmark runs over a pre-generated workload (names of configurable depth and
+// fan-out, Zipf popularity, churn of the name universe), so only the measured operation is
+// timed. Results are printed as tab-separated rows, one row per benchmark:
+//
+//   Benchmark Depth FanOut Names ZipfS Churn Ops Seconds OpsPerSecond NsPerOp HitRatio
+//
+// Example:
+//   ./waf --run "ndn-microbenchmark --Suite=cs --Names=100000 --ZipfS=0.9 --Output=cs.txt"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "../utils/trie-with-policy.h"
+#include "../utils/persistent-policy.h"
+#include "../utils/lru-policy.h"
+#include "../utils/fifo-policy.h"
+#include "../utils/random-policy.h"
+#include "../utils/arc-policy.h"
+#include "../utils/slru-policy.h"
+#include "../utils/tinylfu-policy.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <time.h>
+
+using namespace ns3;
+using namespace ns3::ndn;
+using namespace ns3::ndn::ndnSIM;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.Microbenchmark");
+
+struct Parameters
+{
+  uint32_t m_depth;
+  uint32_t m_fanOut;
+  uint32_t m_names;
+  uint32_t m_operations;
+  double m_zipfS;
+  double m_churn;
+  uint32_t m_cacheSize;
+  uint32_t m_payloadSize;
+};
+
+/**
+ * @brief Pre-generated request stream
+ *
+ * m_universe holds all distinct names that were ever popular (in order of creation),
+ * m_requests is the sequence of requested names drawn from the Zipf distribution over
+ * the current set of popular names.  With probability Churn, a request replaces the
+ * requested popular name with a fresh one (new content becomes popular)
+ */
+struct Workload
+{
+  std::vector< Ptr<NameComponents> > m_universe;
+  std::vector< Ptr<NameComponents> > m_requests;
+};
+
+class Payload : public SimpleRefCount<Payload>
+{
+};
+
+static volatile uint64_t g_sink = 0; // prevents the compiler from dropping measured work
+
+static double
+Now ()
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static Ptr<NameComponents>
+GenerateName (const Parameters &params, UniformVariable &rand, uint32_t id)
+{
+  Ptr<NameComponents> name = Create<NameComponents> ();
+  for (uint32_t level = 1; level < params.m_depth; level++)
+    {
+      (*name) ("c" + boost::lexical_cast<std::string> (rand.GetInteger (0, params.m_fanOut - 1)));
+    }
+  (*name) ("n" + boost::lexical_cast<std::string> (id));
+  return name;
+}
+
+static Workload
+GenerateWorkload (const Parameters &params)
+{
+  UniformVariable rand;
+  Workload workload;
+
+  std::vector< Ptr<NameComponents> > popular;
+  for (uint32_t i = 0; i < params.m_names; i++)
+    {
+      popular.push_back (GenerateName (params, rand, i));
+      workload.m_universe.push_back (popular.back ());
+    }
+
+  std::vector<double> cdf (params.m_names);
+  double sum = 0;
+  for (uint32_t rank = 0; rank < params.m_names; rank++)
+    {
+      sum += 1.0 / std::pow (rank + 1.0, params.m_zipfS);
+      cdf [rank] = sum;
+    }
+
+  workload.m_requests.reserve (params.m_operations);
+  for (uint32_t i = 0; i < params.m_operations; i++)
+    {
+      double u = rand.GetValue (0, sum);
+      uint32_t rank = std::min<uint32_t> (std::lower_bound (cdf.begin (), cdf.end (), u) - cdf.begin (),
+                                          params.m_names - 1);
+
+      if (params.m_churn > 0 && rand.GetValue () < params.m_churn)
+        {
+          popular [rank] = GenerateName (params, rand, workload.m_universe.size ());
+          workload.m_universe.push_back (popular [rank]);
+        }
+
+      workload.m_requests.push_back (popular [rank]);
+    }
+
+  return workload;
+}
+
+static void
+PrintHeader (std::ostream &os)
+{
+  os << "Benchmark" << "\t"
+     << "Depth" << "\t"
+     << "FanOut" << "\t"
+     << "Names" << "\t"
+     << "ZipfS" << "\t"
+     << "Churn" << "\t"
+     << "Ops" << "\t"
+     << "Seconds" << "\t"
+     << "OpsPerSecond" << "\t"
+     << "NsPerOp" << "\t"
+     << "HitRatio" << "\n";
+}
+
+static void
+PrintResult (std::ostream &os, const Parameters &params, const std::string &benchmark,
+             uint64_t ops, double seconds, double hitRatio = -1)
+{
+  os << benchmark << "\t"
+     << params.m_depth << "\t"
+     << params.m_fanOut << "\t"
+     << params.m_names << "\t"
+     << params.m_zipfS << "\t"
+     << params.m_churn << "\t"
+     << ops << "\t"
+     << seconds << "\t"
+     << (seconds > 0 ? ops / seconds : 0) << "\t"
+     << (ops > 0 ? seconds * 1e9 / ops : 0) << "\t";
+  if (hitRatio >= 0)
+    os << hitRatio;
+  else
+    os << "-";
+  os << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// trie_with_policy
+////////////////////////////////////////////////////////////////////////////////
+
+template<class Policy>
+static void
+BenchmarkTrieEviction (std::ostream &os, const Parameters &params, const Workload &workload,
+                       const std::string &benchmark)
+{
+  typedef trie_with_policy<NameComponents, smart_pointer_payload_traits<Payload>, Policy> trie;
+  trie cache;
+  cache.getPolicy ().set_max_size (params.m_cacheSize);
+
+  Ptr<Payload> payload = Create<Payload> ();
+  uint64_t hits = 0;
+
+  double start = Now ();
+  for (std::vector< Ptr<NameComponents> >::const_iterator name = workload.m_requests.begin ();
+       name != workload.m_requests.end ();
+       name++)
+    {
+      // lookup lets the policy see the hit (insert of an existing key does not)
+      if (cache.find_exact (**name) != cache.end ())
+        hits++;
+      else
+        cache.insert (**name, payload);
+    }
+  double seconds = Now () - start;
+
+  PrintResult (os, params, benchmark, workload.m_requests.size (), seconds,
+               static_cast<double> (hits) / workload.m_requests.size ());
+}
+
+static void
+BenchmarkTrie (std::ostream &os, const Parameters &params, const Workload &workload)
+{
+  typedef trie_with_policy<NameComponents, smart_pointer_payload_traits<Payload>, persistent_policy_traits> trie;
+  trie table;
+  table.getPolicy ().set_max_size (0);
+
+  Ptr<Payload> payload = Create<Payload> ();
+
+  // insert
+  double start = Now ();
+  for (std::vector< Ptr<NameComponents> >::const_iterator name = workload.m_universe.begin ();
+       name != workload.m_universe.end ();
+       name++)
+    {
+      table.insert (**name, payload);
+    }
+  PrintResult (os, params, "trie-insert", workload.m_universe.size (), Now () - start);
+
+  // longest prefix match of a name that extends a stored name (FIB/PIT lookup of a Data)
+  std::vector<NameComponents> longer;
+  longer.reserve (workload.m_requests.size ());
+  for (std::vector< Ptr<NameComponents> >::const_iterator name = workload.m_requests.begin ();
+       name != workload.m_requests.end ();
+       name++)
+    {
+      longer.push_back (**name);
+      longer.back () (std::string ("segment"));
+    }
+
+  uint64_t hits = 0;
+  start = Now ();
+  for (std::vector<NameComponents>::const_iterator name = longer.begin ();
+       name != longer.end ();
+       name++)
+    {
+      if (table.longest_prefix_match (*name) != table.end ())
+        hits++;
+    }
+  PrintResult (os, params, "trie-lpm", longer.size (), Now () - start,
+               static_cast<double> (hits) / longer.size ());
+
+  // deepest prefix match of a shorter name (cache lookup of an Interest for a prefix)
+  std::vector<NameComponents> shorter;
+  shorter.reserve (workload.m_requests.size ());
+  for (std::vector< Ptr<NameComponents> >::const_iterator name = workload.m_requests.begin ();
+       name != workload.m_requests.end ();
+       name++)
+    {
+      shorter.push_back ((*name)->cut (1));
+    }
+
+  hits = 0;
+  start = Now ();
+  for (std::vector<NameComponents>::const_iterator name = shorter.begin ();
+       name != shorter.end ();
+       name++)
+    {
+      if (table.deepest_prefix_match (*name) != table.end ())
+        hits++;
+    }
+  PrintResult (os, params, "trie-deepest-prefix", shorter.size (), Now () - start,
+               static_cast<double> (hits) / shorter.size ());
+
+  // erase
+  start = Now ();
+  for (std::vector< Ptr<NameComponents> >::const_iterator name = workload.m_universe.begin ();
+       name != workload.m_universe.end ();
+       name++)
+    {
+      table.erase (**name);
+    }
+  PrintResult (os, params, "trie-erase", workload.m_universe.size (), Now () - start);
+
+  BenchmarkTrieEviction<lru_policy_traits> (os, params, workload, "trie-evict-lru");
+  BenchmarkTrieEviction<fifo_policy_traits> (os, params, workload, "trie-evict-fifo");
+  BenchmarkTrieEviction<random_policy_traits> (os, params, workload, "trie-evict-random");
+  BenchmarkTrieEviction<arc_policy_traits> (os, params, workload, "trie-evict-arc");
+  BenchmarkTrieEviction<slru_policy_traits> (os, params, workload, "trie-evict-slru");
+  BenchmarkTrieEviction<tinylfu_policy_traits> (os, params, workload, "trie-evict-tinylfu");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PitImpl
+////////////////////////////////////////////////////////////////////////////////
+
+static void
+BenchmarkPit (std::ostream &os, const Parameters &params, const Workload &workload,
+              const std::string &pitClass, const std::string &benchmark)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  StackHelper ndnHelper;
+  ndnHelper.SetPit (pitClass, "MaxSize", boost::lexical_cast<std::string> (params.m_cacheSize));
+  ndnHelper.Install (node);
+
+  Ptr<App> app = CreateObject<App> ();
+  node->AddApplication (app);
+  Ptr<Face> face = CreateObject<AppFace> (app);
+  node->GetObject<Fib> ()->Add (Create<NameComponents> (), face, 0);
+
+  Ptr<Pit> pit = node->GetObject<Pit> ();
+
+  UniformVariable rand;
+  std::vector< Ptr<const InterestHeader> > interests;
+  std::vector< Ptr<const ContentObjectHeader> > data;
+  interests.reserve (workload.m_requests.size ());
+  data.reserve (workload.m_requests.size ());
+  for (std::vector< Ptr<NameComponents> >::const_iterator name = workload.m_requests.begin ();
+       name != workload.m_requests.end ();
+       name++)
+    {
+      Ptr<InterestHeader> interest = Create<InterestHeader> ();
+      interest->SetName (*name);
+      interest->SetNonce (rand.GetValue ());
+      interest->SetInterestLifetime (Seconds (1.0));
+      interests.push_back (interest);
+
+      Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
+      header->SetName (*name);
+      data.push_back (header);
+    }
+
+  // create entries (aggregation is counted as a hit)
+  uint64_t hits = 0;
+  double start = Now ();
+  for (std::vector< Ptr<const InterestHeader> >::const_iterator interest = interests.begin ();
+       interest != interests.end ();
+       interest++)
+    {
+      if (pit->Lookup (**interest) != 0)
+        hits++;
+      else
+        pit->Create (*interest);
+    }
+  PrintResult (os, params, benchmark + "-create", interests.size (), Now () - start,
+               static_cast<double> (hits) / interests.size ());
+
+  // Data lookups
+  hits = 0;
+  start = Now ();
+  for (std::vector< Ptr<const ContentObjectHeader> >::const_iterator header = data.begin ();
+       header != data.end ();
+       header++)
+    {
+      if (pit->Lookup (**header) != 0)
+        hits++;
+    }
+  PrintResult (os, params, benchmark + "-lookup-data", data.size (), Now () - start,
+               static_cast<double> (hits) / data.size ());
+
+  // satisfy and erase
+  uint32_t entries = pit->GetSize ();
+  start = Now ();
+  for (std::vector< Ptr<const InterestHeader> >::const_iterator interest = interests.begin ();
+       interest != interests.end ();
+       interest++)
+    {
+      Ptr<pit::Entry> entry = pit->Lookup (**interest);
+      if (entry != 0)
+        pit->MarkErased (entry);
+    }
+  PrintResult (os, params, benchmark + "-erase", entries, Now () - start);
+
+  Simulator::Destroy ();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ContentStoreImpl
+////////////////////////////////////////////////////////////////////////////////
+
+static void
+BenchmarkContentStore (std::ostream &os, const Parameters &params, const Workload &workload,
+                       const std::string &csClass, const std::string &benchmark)
+{
+  ObjectFactory factory (csClass);
+  factory.Set ("MaxSize", UintegerValue (params.m_cacheSize));
+  Ptr<ContentStore> cs = factory.Create<ContentStore> ();
+
+  Ptr<Packet> payload = Create<Packet> (params.m_payloadSize);
+
+  std::vector< Ptr<const InterestHeader> > interests;
+  std::vector< Ptr<const ContentObjectHeader> > data;
+  interests.reserve (workload.m_requests.size ());
+  data.reserve (workload.m_requests.size ());
+  for (std::vector< Ptr<NameComponents> >::const_iterator name = workload.m_requests.begin ();
+       name != workload.m_requests.end ();
+       name++)
+    {
+      Ptr<InterestHeader> interest = Create<InterestHeader> ();
+      interest->SetName (*name);
+      interests.push_back (interest);
+
+      Ptr<ContentObjectHeader> header = Create<ContentObjectHeader> ();
+      header->SetName (*name);
+      data.push_back (header);
+    }
+
+  // Lookup, and on a miss, Add (cache the Data that would have been fetched)
+  uint64_t hits = 0;
+  double start = Now ();
+  for (size_t i = 0; i < interests.size (); i++)
+    {
+      if (boost::get<0> (cs->Lookup (interests [i])) != 0)
+        hits++;
+      else
+        cs->Add (data [i], payload);
+    }
+  PrintResult (os, params, benchmark, interests.size (), Now () - start,
+               static_cast<double> (hits) / interests.size ());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// EncodingHelper / DecodingHelper
+////////////////////////////////////////////////////////////////////////////////
+
+static void
+BenchmarkCodec (std::ostream &os, const Parameters &params, const Workload &workload)
+{
+  UniformVariable rand;
+  std::vector<InterestHeader> interests (workload.m_requests.size ());
+  std::vector<ContentObjectHeader> data (workload.m_requests.size ());
+  for (size_t i = 0; i < workload.m_requests.size (); i++)
+    {
+      interests [i].SetName (workload.m_requests [i]);
+      interests [i].SetNonce (rand.GetValue ());
+      interests [i].SetInterestLifetime (Seconds (1.0));
+
+      data [i].SetName (workload.m_requests [i]);
+      data [i].GetSignedInfo ().SetTimestamp (Seconds (1.0));
+      data [i].GetSignedInfo ().SetFreshness (Seconds (10.0));
+    }
+
+  static ContentObjectTail tail;
+
+  std::vector< Ptr<Packet> > packets (interests.size ());
+  double start = Now ();
+  for (size_t i = 0; i < interests.size (); i++)
+    {
+      packets [i] = Create<Packet> ();
+      packets [i]->AddHeader (interests [i]);
+    }
+  PrintResult (os, params, "codec-interest-encode", interests.size (), Now () - start);
+
+  start = Now ();
+  for (size_t i = 0; i < packets.size (); i++)
+    {
+      InterestHeader interest;
+      packets [i]->RemoveHeader (interest);
+      g_sink += interest.GetNonce ();
+    }
+  PrintResult (os, params, "codec-interest-decode", packets.size (), Now () - start);
+
+  start = Now ();
+  for (size_t i = 0; i < data.size (); i++)
+    {
+      packets [i] = Create<Packet> (params.m_payloadSize);
+      packets [i]->AddHeader (data [i]);
+      packets [i]->AddTrailer (tail);
+    }
+  PrintResult (os, params, "codec-data-encode", data.size (), Now () - start);
+
+  start = Now ();
+  for (size_t i = 0; i < packets.size (); i++)
+    {
+      ContentObjectHeader header;
+      packets [i]->RemoveHeader (header);
+      packets [i]->RemoveTrailer (tail);
+      g_sink += packets [i]->GetSize ();
+    }
+  PrintResult (os, params, "codec-data-decode", packets.size (), Now () - start);
+}
+
+int
+main (int argc, char *argv[])
+{
+  Parameters params;
+  params.m_depth = 4;
+  params.m_fanOut = 10;
+  params.m_names = 10000;
+  params.m_operations = 100000;
+  params.m_zipfS = 0.8;
+  params.m_churn = 0.0;
+  params.m_cacheSize = 1000;
+  params.m_payloadSize = 1024;
+
+  std::string suite = "all";
+  std::string output = "-";
+  uint32_t seed = 1;
+  bool header = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("Suite", "Benchmarks to run: all, trie, pit, cs, or codec", suite);
+  cmd.AddValue ("Depth", "Number of components in each name", params.m_depth);
+  cmd.AddValue ("FanOut", "Number of distinct components on each level of the name tree", params.m_fanOut);
+  cmd.AddValue ("Names", "Number of popular names", params.m_names);
+  cmd.AddValue ("Operations", "Number of requests in the workload", params.m_operations);
+  cmd.AddValue ("ZipfS", "Exponent of the Zipf popularity distribution", params.m_zipfS);
+  cmd.AddValue ("Churn", "Probability that a request replaces its popular name with a new one", params.m_churn);
+  cmd.AddValue ("CacheSize", "Maximum number of entries in caches and bounded tables", params.m_cacheSize);
+  cmd.AddValue ("PayloadSize", "Size of Data payload", params.m_payloadSize);
+  cmd.AddValue ("Seed", "Seed of the random number generator", seed);
+  cmd.AddValue ("Output", "Output file (- for standard output)", output);
+  cmd.AddValue ("Header", "Print header line", header);
+  cmd.Parse (argc, argv);
+
+  if (params.m_depth == 0 || params.m_fanOut == 0 || params.m_names == 0)
+    {
+      std::cerr << "Depth, FanOut, and Names should be positive" << std::endl;
+      return 1;
+    }
+
+  SeedManager::SetSeed (seed);
+
+  std::ofstream file;
+  if (output != "-")
+    {
+      file.open (output.c_str (), std::ios::trunc);
+      if (!file.is_open ())
+        {
+          std::cerr << "Cannot open " << output << std::endl;
+          return 1;
+        }
+    }
+  std::ostream &os = (output != "-") ? file : std::cout;
+
+  Workload workload = GenerateWorkload (params);
+
+  if (header)
+    PrintHeader (os);
+
+  if (suite == "all" || suite == "trie")
+    BenchmarkTrie (os, params, workload);
+
+  if (suite == "all" || suite == "pit")
+    {
+      BenchmarkPit (os, params, workload, "ns3::ndn::pit::Persistent", "pit-persistent");
+      BenchmarkPit (os, params, workload, "ns3::ndn::pit::Random", "pit-random");
+    }
+
+  if (suite == "all" || suite == "cs")
+    {
+      BenchmarkContentStore (os, params, workload, "ns3::ndn::cs::Lru", "cs-lru");
+      BenchmarkContentStore (os, params, workload, "ns3::ndn::cs::Fifo", "cs-fifo");
+      BenchmarkContentStore (os, params, workload, "ns3::ndn::cs::Random", "cs-random");
+      BenchmarkContentStore (os, params, workload, "ns3::ndn::cs::Arc", "cs-arc");
+      BenchmarkContentStore (os, params, workload, "ns3::ndn::cs::Slru", "cs-slru");
+      BenchmarkContentStore (os, params, workload, "ns3::ndn::cs::TinyLfu", "cs-tinylfu");
+    }
+
+  if (suite == "all" || suite == "codec")
+    BenchmarkCodec (os, params, workload);
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// ndn-request-trace-convert: convert text request trace to binary format replayed by ns3::ndn::ConsumerTrace
+//
+// Usage: ndn-request-trace-convert <trace.txt> <trace.bin>
+//
+// Each line of the text trace is "<time in seconds> <name>", lines must be sorted by time.
+// If the last component of the name is a decimal number, it is stored as a sequence number
+// and the rest of the name is stored in the name table
+
+#include "ns3/request-trace-format.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <stdint.h>
+
+using namespace ns3::ndn;
+
+template<class T>
+static void
+Write (std::ostream &os, const T &value)
+{
+  os.write (reinterpret_cast<const char*> (&value), sizeof (T));
+}
+
+/**
+ * Split name into prefix and numeric sequence number (if the last component is a number)
+ */
+static void
+SplitName (const std::string &name, std::string &prefix, uint32_t &seq)
+{
+  prefix = name;
+  seq = RequestTraceFormat::NO_SEQ;
+
+  std::string::size_type slash = name.find_last_of ('/');
+  if (slash == std::string::npos || slash + 1 >= name.size () || name.size () - slash - 1 > 10)
+    return;
+
+  char *end;
+  unsigned long long value = strtoull (name.c_str () + slash + 1, &end, 10);
+  if (*end != 0 || value >= RequestTraceFormat::NO_SEQ)
+    return;
+
+  for (const char *c = name.c_str () + slash + 1; c != end; c++)
+    if (*c < '0' || *c > '9')
+      return;
+
+  prefix = name.substr (0, slash);
+  if (prefix.empty ())
+    prefix = "/";
+  seq = static_cast<uint32_t> (value);
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc < 3)
+    {
+      std::cerr << "Usage: " << argv[0] << " <trace.txt> <trace.bin>" << std::endl;
+      return 1;
+    }
+
+  std::ifstream is (argv[1]);
+  if (!is.is_open ())
+    {
+      std::cerr << "Cannot open " << argv[1] << std::endl;
+      return 1;
+    }
+
+  std::ofstream os (argv[2], std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!os.is_open ())
+    {
+      std::cerr << "Cannot open " << argv[2] << std::endl;
+      return 1;
+    }
+
+  RequestTraceFormat::Header header;
+  std::memset (&header, 0, sizeof (header));
+  std::memcpy (header.magic, RequestTraceFormat::MAGIC, sizeof (header.magic));
+  header.recordsOffset = sizeof (header);
+  Write (os, header); // placeholder, rewritten at the end
+
+  std::map<std::string, uint32_t> nameIds;
+  std::vector<const std::string*> names;
+
+  std::string line;
+  uint64_t lineNo = 0;
+  uint64_t lastTime = 0;
+  while (std::getline (is, line))
+    {
+      lineNo++;
+      std::istringstream fields (line);
+      double time;
+      std::string name;
+      if (!(fields >> time >> name))
+        {
+          if (line.find_first_not_of (" \t\r") != std::string::npos)
+            std::cerr << "Skipping malformed line " << lineNo << std::endl;
+          continue;
+        }
+
+      RequestTraceFormat::Record record;
+      record.time = static_cast<uint64_t> (time * 1e9 + 0.5);
+      if (record.time < lastTime)
+        {
+          std::cerr << "Line " << lineNo << ": trace is not sorted by time" << std::endl;
+          return 1;
+        }
+      lastTime = record.time;
+
+      std::string prefix;
+      SplitName (name, prefix, record.seq);
+
+      std::pair<std::map<std::string, uint32_t>::iterator, bool> id =
+        nameIds.insert (std::make_pair (prefix, static_cast<uint32_t> (names.size ())));
+      if (id.second)
+        names.push_back (&id.first->first);
+      record.name = id.first->second;
+
+      Write (os, record);
+      header.recordCount ++;
+    }
+
+  header.nameCount = names.size ();
+  header.namesOffset = header.recordsOffset + header.recordCount * sizeof (RequestTraceFormat::Record);
+
+  uint64_t offset = 0;
+  Write (os, offset);
+  for (std::vector<const std::string*>::iterator name = names.begin (); name != names.end (); name++)
+    {
+      offset += (*name)->size ();
+      Write (os, offset);
+    }
+  for (std::vector<const std::string*>::iterator name = names.begin (); name != names.end (); name++)
+    {
+      os.write ((*name)->data (), (*name)->size ());
+    }
+
+  os.seekp (0);
+  Write (os, header);
+
+  if (!os.good ())
+    {
+      std::cerr << "Error writing " << argv[2] << std::endl;
+      return 1;
+    }
+
+  std::cerr << header.recordCount << " records, " << header.nameCount << " names" << std::endl;
+  return 0;
+}
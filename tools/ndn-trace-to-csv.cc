@@ -0,0 +1,216 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// ndn-trace-to-csv: convert binary trace produced by ns3::ndn::BinaryTraceWriter to CSV
+//
+// Usage: ndn-trace-to-csv <trace.bin> [output.csv]
+
+#include "ns3/binary-trace-format.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <stdint.h>
+
+using namespace ns3::ndn;
+
+template<class T>
+static bool
+Read (std::istream &is, T &value)
+{
+  return !is.read (reinterpret_cast<char*> (&value), sizeof (T)).fail ();
+}
+
+static bool
+ReadString (std::istream &is, std::string &str)
+{
+  uint16_t length;
+  if (!Read (is, length))
+    return false;
+
+  str.resize (length);
+  return length == 0 || !is.read (&str [0], length).fail ();
+}
+
+static void
+WriteCsvString (std::ostream &os, const std::string &str)
+{
+  if (str.find_first_of (",\"\n") == std::string::npos)
+    {
+      os << str;
+      return;
+    }
+
+  os << '"';
+  for (std::string::const_iterator c = str.begin (); c != str.end (); c++)
+    {
+      if (*c == '"')
+        os << '"';
+      os << *c;
+    }
+  os << '"';
+}
+
+static int
+Convert (std::istream &is, std::ostream &os)
+{
+  char magic [sizeof (BinaryTraceFormat::MAGIC)];
+  if (!is.read (magic, sizeof (magic)) ||
+      std::memcmp (magic, BinaryTraceFormat::MAGIC, sizeof (magic)) != 0)
+    {
+      std::cerr << "Not a binary NDN trace" << std::endl;
+      return 1;
+    }
+
+  uint32_t columnCount;
+  if (!Read (is, columnCount) || columnCount > BinaryTraceFormat::MAX_COLUMNS)
+    {
+      std::cerr << "Corrupted trace header" << std::endl;
+      return 1;
+    }
+
+  std::vector<uint8_t> types (columnCount);
+  for (uint32_t i = 0; i < columnCount; i++)
+    {
+      std::string name;
+      if (!Read (is, types [i]) || !ReadString (is, name))
+        {
+          std::cerr << "Corrupted trace header" << std::endl;
+          return 1;
+        }
+
+      if (i > 0) os << ",";
+      WriteCsvString (os, name);
+    }
+  os << "\n";
+  os.precision (10);
+
+  std::vector<std::string> strings;
+  std::vector<uint64_t> values;
+
+  uint8_t chunkType;
+  while (Read (is, chunkType))
+    {
+      if (chunkType == BinaryTraceFormat::CHUNK_STRINGS)
+        {
+          uint32_t first, count;
+          if (!Read (is, first) || !Read (is, count) || first != strings.size ())
+            {
+              std::cerr << "Corrupted string dictionary" << std::endl;
+              return 1;
+            }
+
+          strings.resize (first + count);
+          for (uint32_t i = first; i < first + count; i++)
+            {
+              if (!ReadString (is, strings [i]))
+                {
+                  std::cerr << "Truncated string dictionary" << std::endl;
+                  return 1;
+                }
+            }
+        }
+      else if (chunkType == BinaryTraceFormat::CHUNK_RECORDS)
+        {
+          uint32_t records;
+          if (!Read (is, records))
+            {
+              std::cerr << "Truncated record chunk" << std::endl;
+              return 1;
+            }
+
+          values.resize (static_cast<size_t> (records) * columnCount);
+          if (values.size () > 0 &&
+              !is.read (reinterpret_cast<char*> (&values [0]), values.size () * sizeof (uint64_t)))
+            {
+              std::cerr << "Truncated record chunk" << std::endl;
+              return 1;
+            }
+
+          // values are stored column by column
+          for (uint32_t record = 0; record < records; record++)
+            {
+              for (uint32_t column = 0; column < columnCount; column++)
+                {
+                  if (column > 0) os << ",";
+
+                  uint64_t value = values [static_cast<size_t> (column) * records + record];
+                  switch (types [column])
+                    {
+                    case BinaryTraceFormat::COLUMN_DOUBLE:
+                      {
+                        double d;
+                        std::memcpy (&d, &value, sizeof (double));
+                        os << d;
+                        break;
+                      }
+                    case BinaryTraceFormat::COLUMN_STRING:
+                      if (value < strings.size ())
+                        WriteCsvString (os, strings [value]);
+                      else
+                        os << "#" << value;
+                      break;
+                    default:
+                      os << value;
+                      break;
+                    }
+                }
+              os << "\n";
+            }
+        }
+      else
+        {
+          std::cerr << "Unknown chunk type " << static_cast<int> (chunkType) << std::endl;
+          return 1;
+        }
+    }
+
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+      std::cerr << "Usage: " << argv[0] << " <trace.bin> [output.csv]" << std::endl;
+      return 1;
+    }
+
+  std::ifstream is (argv[1], std::ios::in | std::ios::binary);
+  if (!is.is_open ())
+    {
+      std::cerr << "Cannot open " << argv[1] << std::endl;
+      return 1;
+    }
+
+  if (argc > 2)
+    {
+      std::ofstream os (argv[2], std::ios::out | std::ios::trunc);
+      if (!os.is_open ())
+        {
+          std::cerr << "Cannot open " << argv[2] << std::endl;
+          return 1;
+        }
+      return Convert (is, os);
+    }
+
+  return Convert (is, std::cout);
+}
@@ -0,0 +1,118 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "alias-sampler.h"
+
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+AliasSampler::AliasSampler ()
+{
+}
+
+AliasSampler::AliasSampler (const std::vector<double> &weights)
+{
+  Build (weights);
+}
+
+AliasSampler
+AliasSampler::ZipfMandelbrot (uint32_t n, double q, double s)
+{
+  std::vector<double> weights (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      weights[i] = 1.0 / std::pow (i + 1 + q, s);
+    }
+
+  AliasSampler sampler;
+  sampler.Build (weights);
+  return sampler;
+}
+
+void
+AliasSampler::Build (const std::vector<double> &weights)
+{
+  uint32_t n = weights.size ();
+  m_prob.assign (n, 1.0);
+  m_alias.resize (n);
+  for (uint32_t i = 0; i < n; i++)
+    m_alias[i] = i;
+
+  if (n == 0)
+    return;
+
+  double sum = 0;
+  for (uint32_t i = 0; i < n; i++)
+    sum += weights[i];
+
+  // scaled probabilities: average column height is 1
+  std::vector<double> scaled (n);
+  // indexes of columns below and above average, used as stacks
+  std::vector<uint32_t> small, large;
+  small.reserve (n);
+  large.reserve (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      scaled[i] = weights[i] * n / sum;
+      if (scaled[i] < 1.0)
+        small.push_back (i);
+      else
+        large.push_back (i);
+    }
+
+  while (!small.empty () && !large.empty ())
+    {
+      uint32_t less = small.back (); small.pop_back ();
+      uint32_t more = large.back ();
+
+      m_prob[less]  = scaled[less];
+      m_alias[less] = more;
+
+      // part of the large column fills up the small one
+      scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+      if (scaled[more] < 1.0)
+        {
+          large.pop_back ();
+          small.push_back (more);
+        }
+    }
+
+  // remaining columns are full (up to floating point error)
+  for (std::vector<uint32_t>::iterator i = small.begin (); i != small.end (); i++)
+    m_prob[*i] = 1.0;
+  for (std::vector<uint32_t>::iterator i = large.begin (); i != large.end (); i++)
+    m_prob[*i] = 1.0;
+}
+
+double
+AliasSampler::GetProbability (uint32_t outcome) const
+{
+  uint32_t n = m_prob.size ();
+  double p = m_prob[outcome];
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (m_alias[i] == outcome && i != outcome)
+        p += 1.0 - m_prob[i];
+    }
+  return p / n;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_ALIAS_SAMPLER_H
+#define NDN_ALIAS_SAMPLER_H
+
+#include <vector>
+#include <stdint.h>
+#include <cstddef>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Sampler of a discrete distribution in O(1) time using Walker's alias method
+ *
+ * Table is built once in O(N) time (Vose's algorithm) and uses 8 bytes per outcome.
+ * Each sample needs only one uniform random number in [0, 1)
+ */
+class AliasSampler
+{
+public:
+  /**
+   * @brief Build alias table for outcomes 0..weights.size()-1 with probabilities proportional to weights
+   */
+  AliasSampler (const std::vector<double> &weights);
+
+  /**
+   * @brief Build alias table for Zipf-Mandelbrot distribution: p(k) ~ 1/(k+q)^s, k = 1..n
+   *
+   * Outcome i of the sampler corresponds to rank k = i+1
+   */
+  static AliasSampler
+  ZipfMandelbrot (uint32_t n, double q, double s);
+
+  /**
+   * @brief Get outcome for a uniform random number in [0, 1)
+   */
+  inline uint32_t
+  Sample (double uniform) const;
+
+  /**
+   * @brief Number of outcomes
+   */
+  inline uint32_t
+  GetN () const;
+
+  /**
+   * @brief Probability of outcome, as encoded in the table (for verification purposes; O(N))
+   */
+  double
+  GetProbability (uint32_t outcome) const;
+
+  /**
+   * @brief Memory used by the table
+   */
+  inline size_t
+  GetMemoryUsage () const;
+
+private:
+  AliasSampler ();
+
+  void
+  Build (const std::vector<double> &weights);
+
+private:
+  std::vector<float>    m_prob;  ///< @brief probability to keep the selected column
+  std::vector<uint32_t> m_alias; ///< @brief outcome to choose otherwise
+};
+
+inline uint32_t
+AliasSampler::Sample (double uniform) const
+{
+  double x = uniform * m_prob.size ();
+  uint32_t column = static_cast<uint32_t> (x);
+  if (column >= m_prob.size ()) // protect against rounding at uniform -> 1
+    column = m_prob.size () - 1;
+
+  return (x - column < m_prob[column]) ? column : m_alias[column];
+}
+
+inline uint32_t
+AliasSampler::GetN () const
+{
+  return m_prob.size ();
+}
+
+inline size_t
+AliasSampler::GetMemoryUsage () const
+{
+  return m_prob.capacity () * sizeof (float) + m_alias.capacity () * sizeof (uint32_t);
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ALIAS_SAMPLER_H
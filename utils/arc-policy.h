@@ -0,0 +1,316 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ARC_POLICY_H_
+#define ARC_POLICY_H_
+
+#include "detail/functor-hook.h"
+#include "detail/node-hash.h"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <list>
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Adaptive Replacement Cache (ARC) policy
+ *
+ * Cached entries are split between T1 (seen once recently) and T2 (seen at least twice)
+ * LRU lists.  Hashes of names recently evicted from T1 and T2 are remembered in ghost
+ * lists B1 and B2 (up to max_size in total), and a hit in a ghost list adapts the target
+ * size of T1.  A scan of one-time requests can therefore flush only T1, while frequently
+ * requested entries stay in T2
+ */
+struct arc_policy_traits
+{
+  struct policy_hook_type : public boost::intrusive::list_member_hook<>
+  {
+    policy_hook_type () : frequent (false) { }
+    bool frequent; ///< @brief true if entry is in T2
+  };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::function_hook< detail::MemberHook<Container, policy_hook_type> > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy 
+  {
+    typedef typename detail::HookFunctor<Hook>::type functor;
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    static bool& is_frequent (typename Container::iterator item)
+    {
+      return functor::to_hook_ptr (*item)->frequent;
+    }
+
+    /**
+     * @brief LRU list of hashes of evicted entries
+     */
+    class ghost_list
+    {
+    public:
+      inline bool
+      erase (size_t hash)
+      {
+        typename index::iterator item = index_.find (hash);
+        if (item == index_.end ())
+          return false;
+
+        list_.erase (item->second);
+        index_.erase (item);
+        return true;
+      }
+
+      inline void
+      push_back (size_t hash)
+      {
+        erase (hash);
+        index_ [hash] = list_.insert (list_.end (), hash);
+      }
+
+      inline void
+      pop_front ()
+      {
+        if (list_.empty ())
+          return;
+        index_.erase (list_.front ());
+        list_.pop_front ();
+      }
+
+      inline size_t
+      size () const
+      {
+        return list_.size ();
+      }
+
+      inline void
+      clear ()
+      {
+        list_.clear ();
+        index_.clear ();
+      }
+
+    private:
+      typedef boost::unordered_map<size_t, std::list<size_t>::iterator> index;
+      std::list<size_t> list_;
+      index index_;
+    };
+
+    // T1 is the base container, so that iteration over the policy goes over recent entries
+    class type : public policy_container
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+        , target_ (0)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        lookup (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        size_t hash = detail::node_hash (*item);
+
+        if (max_size_ == 0)
+          {
+            // no limit, nothing to adapt
+            link (item, false);
+            return true;
+          }
+
+        if (b1_.erase (hash))
+          {
+            // recently evicted from T1, should have kept more recent entries
+            target_ = std::min (max_size_, target_ + std::max<size_t> (b2_.size () / (b1_.size () + 1), 1));
+            replace (false);
+            link (item, true);
+          }
+        else if (b2_.erase (hash))
+          {
+            // recently evicted from T2, should have kept more frequent entries
+            size_t delta = std::max<size_t> (b1_.size () / (b2_.size () + 1), 1);
+            target_ = (target_ > delta) ? target_ - delta : 0;
+            replace (true);
+            link (item, true);
+          }
+        else
+          {
+            if (policy_container::size () + b1_.size () >= max_size_)
+              {
+                if (policy_container::size () < max_size_)
+                  {
+                    b1_.pop_front ();
+                    replace (false);
+                  }
+                else
+                  {
+                    evict (t1_front (), false);
+                  }
+              }
+            else
+              {
+                if (size () + b1_.size () + b2_.size () >= 2 * max_size_)
+                  b2_.pop_front ();
+                replace (false);
+              }
+            link (item, false);
+          }
+
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        if (is_frequent (item))
+          t2_.splice (t2_.end (), t2_, t2_.s_iterator_to (*item));
+        else
+          {
+            policy_container::erase (policy_container::s_iterator_to (*item));
+            is_frequent (item) = true;
+            t2_.push_back (*item);
+          }
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        if (is_frequent (item))
+          t2_.erase (t2_.s_iterator_to (*item));
+        else
+          policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        t2_.clear ();
+        b1_.clear ();
+        b2_.clear ();
+        target_ = 0;
+      }
+
+      /**
+       * @brief Number of cached entries (in both T1 and T2)
+       */
+      inline size_t
+      size () const
+      {
+        return policy_container::size () + t2_.size ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        target_ = std::min (target_, max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      inline typename parent_trie::iterator
+      t1_front ()
+      {
+        return &(*policy_container::begin ());
+      }
+
+      inline void
+      link (typename parent_trie::iterator item, bool frequent)
+      {
+        is_frequent (item) = frequent;
+        if (frequent)
+          t2_.push_back (*item);
+        else
+          policy_container::push_back (*item);
+      }
+
+      inline void
+      evict (typename parent_trie::iterator item, bool remember)
+      {
+        if (remember)
+          {
+            if (is_frequent (item))
+              b2_.push_back (detail::node_hash (*item));
+            else
+              b1_.push_back (detail::node_hash (*item));
+          }
+        base_.erase (item);
+      }
+
+      /**
+       * @brief If cache is full, evict one entry from T1 or T2, depending on the adaptive target size of T1
+       */
+      inline void
+      replace (bool hitInB2)
+      {
+        if (size () < max_size_)
+          return;
+
+        size_t t1 = policy_container::size ();
+        if (t1 > 0 && (t1 > target_ || (hitInB2 && t1 == target_) || t2_.empty ()))
+          evict (t1_front (), true);
+        else if (!t2_.empty ())
+          evict (&(*t2_.begin ()), true);
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      size_t target_; ///< @brief adaptive target size of T1
+
+      policy_container t2_;
+      ghost_list b1_;
+      ghost_list b2_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // ARC_POLICY_H_
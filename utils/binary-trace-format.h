@@ -0,0 +1,72 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_BINARY_TRACE_FORMAT_H
+#define NDN_BINARY_TRACE_FORMAT_H
+
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Layout of binary trace files produced by BinaryTraceWriter
+ *
+ * All integers are in host byte order.
+ *
+ * File header:
+ *  - MAGIC (8 bytes)
+ *  - uint32_t number of columns
+ *  - for each column: uint8_t ColumnType, uint16_t name length, name
+ *
+ * Followed by a sequence of chunks, each starting with uint8_t ChunkType:
+ *  - CHUNK_STRINGS: uint32_t first string id, uint32_t count,
+ *    for each string: uint16_t length, bytes
+ *  - CHUNK_RECORDS: uint32_t number of records N, followed by one column at a time,
+ *    N 8-byte values each (uint64_t, IEEE double, or uint64_t string id)
+ *
+ * Dictionary strings are always written before the first record chunk that references them
+ */
+namespace BinaryTraceFormat {
+
+static const char MAGIC[8] = { 'N', 'D', 'N', 'T', 'R', 'C', '0', '1' };
+
+/**
+ * @brief Maximum number of columns in one trace file (size of the fixed-width record)
+ */
+static const uint32_t MAX_COLUMNS = 16;
+
+enum ColumnType
+  {
+    COLUMN_UINT64 = 0,
+    COLUMN_DOUBLE = 1,
+    COLUMN_STRING = 2
+  };
+
+enum ChunkType
+  {
+    CHUNK_STRINGS = 'S',
+    CHUNK_RECORDS = 'R'
+  };
+
+} // namespace BinaryTraceFormat
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_FORMAT_H
@@ -0,0 +1,249 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace-writer.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+
+#include <algorithm>
+#include <sched.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.BinaryTraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+template<class T>
+static void
+Append (std::vector<char> &buffer, const T &value)
+{
+  const char *data = reinterpret_cast<const char*> (&value);
+  buffer.insert (buffer.end (), data, data + sizeof (T));
+}
+
+static void
+AppendString (std::vector<char> &buffer, const std::string &str)
+{
+  uint16_t length = static_cast<uint16_t> (std::min<size_t> (str.size (), 0xFFFF));
+  Append (buffer, length);
+  buffer.insert (buffer.end (), str.begin (), str.begin () + length);
+}
+
+BinaryTraceWriter::BinaryTraceWriter (const std::string &file, size_t queueSize, uint32_t recordsPerChunk)
+  : m_file (file)
+  , m_writtenStrings (0)
+  , m_queue (queueSize)
+  , m_recordsPerChunk (recordsPerChunk)
+  , m_stop (false)
+  , m_started (false)
+  , m_closed (false)
+  , m_records (0)
+{
+  m_chunk.reserve (m_recordsPerChunk);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter ()
+{
+  Close ();
+}
+
+uint32_t
+BinaryTraceWriter::AddColumn (const std::string &name, BinaryTraceFormat::ColumnType type)
+{
+  NS_ASSERT_MSG (!m_started, "All columns should be added before the first record is written");
+  if (m_columns.size () >= BinaryTraceFormat::MAX_COLUMNS)
+    {
+      NS_FATAL_ERROR ("Binary trace cannot have more than " << BinaryTraceFormat::MAX_COLUMNS << " columns");
+    }
+
+  m_columns.push_back (std::make_pair (name, type));
+  return m_columns.size () - 1;
+}
+
+uint32_t
+BinaryTraceWriter::Intern (const std::string &str)
+{
+  std::map<std::string, uint32_t>::iterator item = m_dictionary.find (str);
+  if (item != m_dictionary.end ())
+    return item->second;
+
+  uint32_t id = m_dictionary.size ();
+  m_dictionary.insert (std::make_pair (str, id));
+
+  CriticalSection lock (m_stringsMutex);
+  m_strings.push_back (str);
+  return id;
+}
+
+void
+BinaryTraceWriter::Write (const Record &record)
+{
+  if (!m_started)
+    Start ();
+
+  NS_ASSERT_MSG (!m_closed, "Trace " << m_file << " is already closed");
+
+  while (!m_queue.push (record))
+    {
+      // writer thread is behind, wake it up and give it a chance
+      m_wakeup.SetCondition (true);
+      m_wakeup.Signal ();
+      sched_yield ();
+    }
+  m_records ++;
+
+  if (m_queue.size () > m_recordsPerChunk)
+    {
+      m_wakeup.SetCondition (true);
+      m_wakeup.Signal ();
+    }
+}
+
+void
+BinaryTraceWriter::Close ()
+{
+  if (m_closed)
+    return;
+
+  if (!m_started)
+    Start ();
+
+  m_stop = true;
+  __sync_synchronize ();
+  m_wakeup.SetCondition (true);
+  m_wakeup.Signal ();
+  m_thread->Join ();
+  m_thread = 0;
+
+  m_os.close ();
+  m_closed = true;
+
+  NS_LOG_DEBUG (m_file << ": " << m_records << " records, " << m_strings.size () << " strings");
+}
+
+uint64_t
+BinaryTraceWriter::GetRecordCount () const
+{
+  return m_records;
+}
+
+void
+BinaryTraceWriter::Start ()
+{
+  m_os.open (m_file.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_os.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open binary trace file " << m_file);
+    }
+
+  m_buffer.clear ();
+  m_buffer.insert (m_buffer.end (), BinaryTraceFormat::MAGIC, BinaryTraceFormat::MAGIC + sizeof (BinaryTraceFormat::MAGIC));
+  Append (m_buffer, static_cast<uint32_t> (m_columns.size ()));
+  for (uint32_t i = 0; i < m_columns.size (); i++)
+    {
+      Append (m_buffer, static_cast<uint8_t> (m_columns [i].second));
+      AppendString (m_buffer, m_columns [i].first);
+    }
+  m_os.write (&m_buffer [0], m_buffer.size ());
+
+  m_started = true;
+  m_thread = Create<SystemThread> (MakeCallback (&BinaryTraceWriter::WriterThread, this));
+  m_thread->Start ();
+}
+
+void
+BinaryTraceWriter::WriterThread ()
+{
+  Record record;
+  while (true)
+    {
+      // unlike Wait, TimedWait leaves the condition set; clear it before draining the queue
+      m_wakeup.SetCondition (false);
+
+      bool stop = m_stop;
+      __sync_synchronize ();
+
+      while (m_queue.pop (record))
+        {
+          m_chunk.push_back (record);
+          if (m_chunk.size () >= m_recordsPerChunk)
+            FlushChunk ();
+        }
+
+      if (stop)
+        break;
+
+      m_wakeup.TimedWait (10000000); // 10ms
+    }
+
+  FlushChunk ();
+  m_os.flush ();
+}
+
+void
+BinaryTraceWriter::WriteStrings ()
+{
+  m_buffer.clear ();
+  {
+    CriticalSection lock (m_stringsMutex);
+    if (m_writtenStrings == m_strings.size ())
+      return;
+
+    Append (m_buffer, static_cast<uint8_t> (BinaryTraceFormat::CHUNK_STRINGS));
+    Append (m_buffer, m_writtenStrings);
+    Append (m_buffer, static_cast<uint32_t> (m_strings.size () - m_writtenStrings));
+    for (; m_writtenStrings < m_strings.size (); m_writtenStrings++)
+      {
+        AppendString (m_buffer, m_strings [m_writtenStrings]);
+      }
+  }
+  m_os.write (&m_buffer [0], m_buffer.size ());
+}
+
+void
+BinaryTraceWriter::FlushChunk ()
+{
+  if (m_chunk.size () == 0)
+    return;
+
+  // all strings referenced by the chunk are already in the dictionary
+  WriteStrings ();
+
+  m_buffer.clear ();
+  m_buffer.reserve (1 + sizeof (uint32_t) + m_chunk.size () * m_columns.size () * sizeof (uint64_t));
+
+  Append (m_buffer, static_cast<uint8_t> (BinaryTraceFormat::CHUNK_RECORDS));
+  Append (m_buffer, static_cast<uint32_t> (m_chunk.size ()));
+  for (uint32_t column = 0; column < m_columns.size (); column++)
+    {
+      for (std::vector<Record>::const_iterator record = m_chunk.begin ();
+           record != m_chunk.end ();
+           record++)
+        {
+          Append (m_buffer, record->m_values [column]);
+        }
+    }
+  m_os.write (&m_buffer [0], m_buffer.size ());
+
+  m_chunk.clear ();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,181 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_BINARY_TRACE_WRITER_H
+#define NDN_BINARY_TRACE_WRITER_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/system-condition.h"
+
+#include "binary-trace-format.h"
+#include "spsc-queue.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <cstring>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Writer of binary columnar traces (see BinaryTraceFormat)
+ *
+ * Records are fixed-width (8 bytes per column) and are handed over to a
+ * background writer thread through a lock-free single-producer single-consumer
+ * queue, so the simulation thread never formats or writes anything. Strings
+ * (names, face descriptions, etc.) are replaced with IDs from a dictionary that
+ * is dumped to the file incrementally.
+ *
+ * Usage:
+ *
+ *     Ptr<BinaryTraceWriter> writer = Create<BinaryTraceWriter> ("trace.bin");
+ *     writer->AddColumn ("Time", BinaryTraceFormat::COLUMN_DOUBLE);
+ *     writer->AddColumn ("Node", BinaryTraceFormat::COLUMN_STRING);
+ *     ...
+ *     BinaryTraceWriter::Record record;
+ *     record.SetDouble (0, Simulator::Now ().ToDouble (Time::S));
+ *     record.SetString (1, writer->Intern ("node1"));
+ *     writer->Write (record);
+ *
+ * Use tools/ndn-trace-to-csv to convert the trace to CSV
+ */
+class BinaryTraceWriter : public SimpleRefCount<BinaryTraceWriter>
+{
+public:
+  /**
+   * @brief Fixed-width trace record
+   */
+  struct Record
+  {
+    inline void
+    SetUint (uint32_t column, uint64_t value)
+    {
+      m_values [column] = value;
+    }
+
+    inline void
+    SetDouble (uint32_t column, double value)
+    {
+      std::memcpy (&m_values [column], &value, sizeof (double));
+    }
+
+    inline void
+    SetString (uint32_t column, uint32_t stringId)
+    {
+      m_values [column] = stringId;
+    }
+
+    uint64_t m_values [BinaryTraceFormat::MAX_COLUMNS];
+  };
+
+  /**
+   * @brief Create writer (file is not touched until the first record or Close)
+   * @param file name of the trace file
+   * @param queueSize maximum number of records pending to be written
+   * @param recordsPerChunk number of records in one columnar chunk
+   */
+  BinaryTraceWriter (const std::string &file, size_t queueSize = 65536, uint32_t recordsPerChunk = 4096);
+
+  /**
+   * @brief Flushes all pending records and closes the file
+   */
+  ~BinaryTraceWriter ();
+
+  /**
+   * @brief Add column to the trace schema
+   *
+   * All columns should be added before the first record is written
+   *
+   * @returns index of the column
+   */
+  uint32_t
+  AddColumn (const std::string &name, BinaryTraceFormat::ColumnType type);
+
+  /**
+   * @brief Get ID of the string in the trace dictionary (string is added if necessary)
+   *
+   * Results should be cached by the caller whenever possible
+   */
+  uint32_t
+  Intern (const std::string &str);
+
+  /**
+   * @brief Queue record for writing
+   *
+   * Blocks only when the writer thread falls behind and the queue is full
+   */
+  void
+  Write (const Record &record);
+
+  /**
+   * @brief Flush all pending records, stop the writer thread and close the file
+   */
+  void
+  Close ();
+
+  /**
+   * @brief Get number of records written so far
+   */
+  uint64_t
+  GetRecordCount () const;
+
+private:
+  void
+  Start ();
+
+  void
+  WriterThread ();
+
+  void
+  FlushChunk ();
+
+  void
+  WriteStrings ();
+
+private:
+  std::string m_file;
+  std::ofstream m_os;
+  std::vector< std::pair<std::string, BinaryTraceFormat::ColumnType> > m_columns;
+
+  std::map<std::string, uint32_t> m_dictionary; ///< \brief string to ID map (simulation thread only)
+  std::vector<std::string> m_strings;           ///< \brief strings by ID (shared, guarded by m_stringsMutex)
+  SystemMutex m_stringsMutex;
+  uint32_t m_writtenStrings;                    ///< \brief number of strings already in the file (writer thread only)
+
+  ndnSIM::spsc_queue<Record> m_queue;
+  std::vector<Record> m_chunk;
+  uint32_t m_recordsPerChunk;
+  std::vector<char> m_buffer;
+
+  Ptr<SystemThread> m_thread;
+  SystemCondition m_wakeup;
+  volatile bool m_stop;
+  bool m_started;
+  bool m_closed;
+  uint64_t m_records;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_WRITER_H
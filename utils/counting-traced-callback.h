@@ -0,0 +1,199 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_COUNTING_TRACED_CALLBACK_H
+#define NDN_COUNTING_TRACED_CALLBACK_H
+
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Global switch of the tracing mode for CountingTracedCallback trace sources
+ */
+class TraceMode
+{
+public:
+  /**
+   * @brief Enable or disable counters-only mode
+   *
+   * In counters-only mode trace sources only count events and never invoke connected callbacks
+   */
+  static void
+  SetCountersOnly (bool countersOnly);
+
+  /**
+   * @brief Check if counters-only mode is enabled
+   */
+  static inline bool
+  IsCountersOnly ()
+  {
+    return s_countersOnly;
+  }
+
+private:
+  static bool s_countersOnly;
+};
+
+/**
+ * @brief TracedCallback that costs a counter increment and a branch when nothing is connected
+ *
+ * Arguments are passed by reference and are converted to the trace source signature
+ * (e.g., Ptr<InterestHeader> to Ptr<const InterestHeader>) only when callbacks are actually invoked.
+ * The number of fired events is always counted (GetCount).
+ * Events can also be mirrored to another trace source of the same type (SetMirror).
+ *
+ * If compiled with NDN_TRACES_COUNT_ONLY defined, callbacks are never invoked
+ */
+template<typename T1 = empty, typename T2 = empty,
+         typename T3 = empty, typename T4 = empty>
+class CountingTracedCallback : public TracedCallback<T1, T2, T3, T4>
+{
+public:
+  typedef TracedCallback<T1, T2, T3, T4> super;
+
+  CountingTracedCallback ()
+    : m_connected (false)
+    , m_count (0)
+    , m_mirror (0)
+  {
+  }
+
+  void
+  ConnectWithoutContext (const CallbackBase &callback)
+  {
+    super::ConnectWithoutContext (callback);
+    m_connected = true;
+  }
+
+  void
+  Connect (const CallbackBase &callback, std::string path)
+  {
+    super::Connect (callback, path);
+    m_connected = true;
+  }
+
+  // Disconnect calls are inherited: once connected, the trace source stays "connected"
+  // (TracedCallback does not report whether any callbacks are left)
+
+  /**
+   * @brief Check if any callback was ever connected to the trace source
+   */
+  inline bool
+  IsConnected () const
+  {
+    return m_connected;
+  }
+
+  /**
+   * @brief Fire `mirror' (0 to stop) each time this trace source is fired
+   *
+   * Unlike connecting a callback that fires `mirror', this does not make this trace source connected,
+   * so it stays a counter increment and two branches when nothing is connected to either of them
+   */
+  inline void
+  SetMirror (const CountingTracedCallback *mirror)
+  {
+    m_mirror = mirror;
+  }
+
+  /**
+   * @brief Get number of times the trace source was fired
+   */
+  inline uint64_t
+  GetCount () const
+  {
+    return m_count;
+  }
+
+  inline void
+  operator() () const
+  {
+    m_count ++;
+    if (ShouldInvoke ())
+      super::operator() ();
+    if (m_mirror != 0)
+      (*m_mirror) ();
+  }
+
+  template<class A1>
+  inline void
+  operator() (const A1 &a1) const
+  {
+    m_count ++;
+    if (ShouldInvoke ())
+      super::operator() (a1);
+    if (m_mirror != 0)
+      (*m_mirror) (a1);
+  }
+
+  template<class A1, class A2>
+  inline void
+  operator() (const A1 &a1, const A2 &a2) const
+  {
+    m_count ++;
+    if (ShouldInvoke ())
+      super::operator() (a1, a2);
+    if (m_mirror != 0)
+      (*m_mirror) (a1, a2);
+  }
+
+  template<class A1, class A2, class A3>
+  inline void
+  operator() (const A1 &a1, const A2 &a2, const A3 &a3) const
+  {
+    m_count ++;
+    if (ShouldInvoke ())
+      super::operator() (a1, a2, a3);
+    if (m_mirror != 0)
+      (*m_mirror) (a1, a2, a3);
+  }
+
+  template<class A1, class A2, class A3, class A4>
+  inline void
+  operator() (const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4) const
+  {
+    m_count ++;
+    if (ShouldInvoke ())
+      super::operator() (a1, a2, a3, a4);
+    if (m_mirror != 0)
+      (*m_mirror) (a1, a2, a3, a4);
+  }
+
+private:
+  inline bool
+  ShouldInvoke () const
+  {
+#ifdef NDN_TRACES_COUNT_ONLY
+    return false;
+#else
+    return m_connected && !TraceMode::IsCountersOnly ();
+#endif
+  }
+
+private:
+  bool m_connected;
+  mutable uint64_t m_count;
+  const CountingTracedCallback *m_mirror;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_COUNTING_TRACED_CALLBACK_H
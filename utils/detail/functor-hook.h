@@ -21,7 +21,10 @@
 #ifndef FUNCTOR_HOOK_H_
 #define FUNCTOR_HOOK_H_
 
+#include "multi-type-container.h"
+
 #include <boost/intrusive/parent_from_member.hpp>
+#include <boost/intrusive/options.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -62,6 +65,48 @@ struct FunctorHook
   }
 };
 
+/**
+ * @brief Functor hook pointing to policy_hook_ member of the trie node
+ *
+ * Allows a policy to use the same code path (HookFunctor<Hook>::type::to_hook_ptr) to access
+ * its hook, whether it is used alone or as a part of multi_policy_traits
+ */
+template<class ValueType, class HookType>
+struct MemberHook
+{
+  typedef HookType              hook_type;
+  typedef hook_type*            hook_ptr;
+  typedef const hook_type*      const_hook_ptr;
+
+  typedef ValueType             value_type;
+  typedef value_type*           pointer;
+  typedef const value_type*     const_pointer;
+
+  static hook_ptr to_hook_ptr (value_type &value)
+  {  return &value.policy_hook_; }
+
+  static const_hook_ptr to_hook_ptr (const value_type &value)
+  {  return &value.policy_hook_; }
+
+  static pointer to_value_ptr (hook_ptr n)
+  {  return boost::intrusive::get_parent_from_member<value_type> (n, &value_type::policy_hook_); }
+
+  static const_pointer to_value_ptr (const_hook_ptr n)
+  {  return boost::intrusive::get_parent_from_member<value_type> (n, &value_type::policy_hook_); }
+};
+
+/**
+ * @brief Extract functor from boost::intrusive::function_hook option
+ */
+template<class Hook>
+struct HookFunctor;
+
+template<class Functor>
+struct HookFunctor< boost::intrusive::function_hook<Functor> >
+{
+  typedef Functor type;
+};
+
 } // detail
 } // ndnSIM
 } // ndn
@@ -0,0 +1,52 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NODE_HASH_H_
+#define NODE_HASH_H_
+
+#include <boost/functional/hash.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Hash of the full key (all components from the root) of the trie node
+ *
+ * Used by policies that need to remember entries after they are removed from the trie
+ * (ghost lists, frequency sketches)
+ */
+template<class Container>
+inline size_t
+node_hash (const Container &node)
+{
+  size_t seed = 0;
+  for (const Container *item = &node; item->parent () != 0; item = item->parent ())
+    {
+      boost::hash_combine (seed, item->key ());
+    }
+  return seed;
+}
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // NODE_HASH_H_
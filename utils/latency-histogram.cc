@@ -0,0 +1,199 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "latency-histogram.h"
+
+#include <limits>
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+static const uint64_t SUB_BUCKETS = 1 << LatencyHistogram::SUB_BUCKET_BITS;
+static const uint64_t HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+
+LatencyHistogram::LatencyHistogram ()
+  : m_count (0)
+  , m_min (std::numeric_limits<uint64_t>::max ())
+  , m_max (0)
+  , m_sum (0)
+{
+}
+
+uint32_t
+LatencyHistogram::GetIndex (uint64_t value)
+{
+  if (value < SUB_BUCKETS)
+    return value;
+
+  uint32_t msb = 63 - __builtin_clzll (value);
+  uint32_t exponent = msb - SUB_BUCKET_BITS + 1;
+  uint64_t mantissa = value >> exponent; // in [HALF_SUB_BUCKETS, SUB_BUCKETS)
+
+  return SUB_BUCKETS + (exponent - 1) * HALF_SUB_BUCKETS + (mantissa - HALF_SUB_BUCKETS);
+}
+
+uint64_t
+LatencyHistogram::GetLowerBound (uint32_t index)
+{
+  if (index < SUB_BUCKETS)
+    return index;
+
+  uint32_t exponent = (index - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+  uint64_t mantissa = (index - SUB_BUCKETS) % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+  return mantissa << exponent;
+}
+
+uint64_t
+LatencyHistogram::GetUpperBound (uint32_t index)
+{
+  if (index < SUB_BUCKETS)
+    return index;
+
+  uint32_t exponent = (index - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+  return GetLowerBound (index) + ((static_cast<uint64_t> (1) << exponent) - 1);
+}
+
+void
+LatencyHistogram::Record (const Time &latency)
+{
+  int64_t value = latency.GetNanoSeconds ();
+  Record (static_cast<uint64_t> (value > 0 ? value : 0));
+}
+
+void
+LatencyHistogram::Record (uint64_t nanoseconds)
+{
+  uint32_t index = GetIndex (nanoseconds);
+  if (index >= m_counts.size ())
+    m_counts.resize (index + 1, 0);
+
+  m_counts [index] ++;
+  m_count ++;
+  m_sum += nanoseconds;
+  m_min = std::min (m_min, nanoseconds);
+  m_max = std::max (m_max, nanoseconds);
+}
+
+LatencyHistogram &
+LatencyHistogram::operator += (const LatencyHistogram &other)
+{
+  if (other.m_counts.size () > m_counts.size ())
+    m_counts.resize (other.m_counts.size (), 0);
+
+  for (uint32_t index = 0; index < other.m_counts.size (); index++)
+    {
+      m_counts [index] += other.m_counts [index];
+    }
+
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_min = std::min (m_min, other.m_min);
+  m_max = std::max (m_max, other.m_max);
+  return *this;
+}
+
+void
+LatencyHistogram::Reset ()
+{
+  m_counts.clear ();
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max ();
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint64_t
+LatencyHistogram::GetCount () const
+{
+  return m_count;
+}
+
+Time
+LatencyHistogram::GetMin () const
+{
+  if (m_count == 0)
+    return Time (0);
+  return NanoSeconds (m_min);
+}
+
+Time
+LatencyHistogram::GetMax () const
+{
+  return NanoSeconds (m_max);
+}
+
+Time
+LatencyHistogram::GetMean () const
+{
+  if (m_count == 0)
+    return Time (0);
+  return NanoSeconds (static_cast<uint64_t> (m_sum / m_count));
+}
+
+Time
+LatencyHistogram::GetPercentile (double percentile) const
+{
+  if (m_count == 0)
+    return Time (0);
+
+  uint64_t target = static_cast<uint64_t> (std::ceil (percentile / 100.0 * m_count));
+  target = std::max<uint64_t> (1, std::min (target, m_count));
+
+  uint64_t seen = 0;
+  for (uint32_t index = 0; index < m_counts.size (); index++)
+    {
+      seen += m_counts [index];
+      if (seen >= target)
+        {
+          uint64_t lower = GetLowerBound (index);
+          uint64_t value = lower + (GetUpperBound (index) - lower) / 2;
+          value = std::max (m_min, std::min (m_max, value));
+          return NanoSeconds (value);
+        }
+    }
+
+  return NanoSeconds (m_max);
+}
+
+void
+LatencyHistogram::PrintHeader (std::ostream &os)
+{
+  os << "Count" << "\t"
+     << "Mean" << "\t"
+     << "P50" << "\t"
+     << "P90" << "\t"
+     << "P99" << "\t"
+     << "P99.9" << "\t"
+     << "Max";
+}
+
+void
+LatencyHistogram::Print (std::ostream &os) const
+{
+  os << m_count << "\t"
+     << GetMean ().ToDouble (Time::S) << "\t"
+     << GetPercentile (50).ToDouble (Time::S) << "\t"
+     << GetPercentile (90).ToDouble (Time::S) << "\t"
+     << GetPercentile (99).ToDouble (Time::S) << "\t"
+     << GetPercentile (99.9).ToDouble (Time::S) << "\t"
+     << GetMax ().ToDouble (Time::S);
+}
+
+} // namespace ndn
+} // namespace ns3
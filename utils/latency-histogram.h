@@ -0,0 +1,126 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_LATENCY_HISTOGRAM_H
+#define NDN_LATENCY_HISTOGRAM_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+#include <stdint.h>
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Fixed-precision log-linear (HDR-style) latency histogram
+ *
+ * Values below 2^SUB_BUCKET_BITS nanoseconds are counted exactly, larger values
+ * are counted in buckets of 2^(SUB_BUCKET_BITS-1) linear sub-buckets per power
+ * of two, i.e., with relative error below 2^-(SUB_BUCKET_BITS-1) (~3%).
+ * Memory is bounded by the largest recorded value (at most ~2000 counters) and
+ * does not depend on the number of samples.
+ *
+ * Histograms with the same precision can be merged, e.g., to get percentiles over
+ * all consumers in the network
+ */
+class LatencyHistogram
+{
+public:
+  static const uint32_t SUB_BUCKET_BITS = 6;
+
+  LatencyHistogram ();
+
+  /**
+   * @brief Record one latency sample
+   */
+  void
+  Record (const Time &latency);
+
+  /**
+   * @brief Record one latency sample, specified in nanoseconds
+   */
+  void
+  Record (uint64_t nanoseconds);
+
+  /**
+   * @brief Add all samples from another histogram
+   */
+  LatencyHistogram &
+  operator += (const LatencyHistogram &other);
+
+  /**
+   * @brief Remove all samples
+   */
+  void
+  Reset ();
+
+  uint64_t
+  GetCount () const;
+
+  Time
+  GetMin () const;
+
+  Time
+  GetMax () const;
+
+  Time
+  GetMean () const;
+
+  /**
+   * @brief Get latency below which the specified percent of samples lie
+   * @param percentile value in [0, 100] range (e.g., 99.9)
+   */
+  Time
+  GetPercentile (double percentile) const;
+
+  /**
+   * @brief Print tab-separated summary: count, mean, p50, p90, p99, p99.9, max (in seconds)
+   */
+  void
+  Print (std::ostream &os) const;
+
+  /**
+   * @brief Print header for Print output
+   */
+  static void
+  PrintHeader (std::ostream &os);
+
+private:
+  static uint32_t
+  GetIndex (uint64_t value);
+
+  static uint64_t
+  GetLowerBound (uint32_t index);
+
+  static uint64_t
+  GetUpperBound (uint32_t index);
+
+private:
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double   m_sum;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LATENCY_HISTOGRAM_H
@@ -38,13 +38,13 @@ std::ostream &
 operator << (std::ostream &os, const LoadStats::stats_tuple &tuple);
 
 void
-LoadStatsFace::Step ()
+LoadStatsFace::Step (uint32_t steps)
 {
-  m_count.Step ();
-  m_satisfied.Step ();
-  m_unsatisfied.Step ();
-  m_tx.Step ();
-  m_rx.Step ();
+  m_count.Step (steps);
+  m_satisfied.Step (steps);
+  m_unsatisfied.Step (steps);
+  m_tx.Step (steps);
+  m_rx.Step (steps);
 }
 
 struct update_retval
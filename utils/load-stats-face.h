@@ -31,7 +31,7 @@ class LoadStatsFace
 {
 public:
   void
-  Step ();
+  Step (uint32_t steps = 1);
 
   inline LoadStats&
   count ();
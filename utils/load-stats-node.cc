@@ -21,39 +21,109 @@
 #include "load-stats-node.h"
 #include "ns3/ndn-face.h"
 #include "ns3/log.h"
-#include <boost/lambda/lambda.hpp>
-#include <boost/lambda/bind.hpp>
-
-namespace ll = boost::lambda;
-
 NS_LOG_COMPONENT_DEFINE ("ndn.LoadStatsNode");
 
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
+LoadStatsFace &
+LoadStatsFaceContainer::operator [] (ns3::Ptr<Face> face)
+{
+  return (*this) [face->GetId ()];
+}
+
+const LoadStatsFace *
+LoadStatsFaceContainer::find (ns3::Ptr<Face> face) const
+{
+  return find (face->GetId ());
+}
+
 void
-LoadStatsNode::Step ()
+LoadStatsFaceContainer::erase (uint32_t faceId)
 {
-  NS_LOG_FUNCTION (this);
-  
-  m_pit.Step ();
-  
-  for (stats_container::iterator item = m_incoming.begin ();
-       item != m_incoming.end ();
-       item ++)
+  if (!has (faceId))
+    return;
+
+  m_faces [faceId] = LoadStatsFace ();
+  m_present [faceId] = false;
+  m_size --;
+}
+
+void
+LoadStatsFaceContainer::Step (uint32_t steps)
+{
+  for (uint32_t faceId = 0; faceId < m_faces.size (); faceId ++)
     {
-      item->second.Step ();
+      if (m_present [faceId])
+        m_faces [faceId].Step (steps);
     }
-  
-  for (stats_container::iterator item = m_outgoing.begin ();
-       item != m_outgoing.end ();
-       item ++)
+}
+
+void
+LoadStatsFaceContainer::Satisfy (const LoadStatsFaceContainer &origin)
+{
+  for (uint32_t faceId = 0; faceId < origin.limit (); faceId ++)
     {
-      item->second.Step ();
+      if (origin.has (faceId))
+        (*this) [faceId].satisfied ()++;
     }
 }
 
+void
+LoadStatsFaceContainer::Timeout (const LoadStatsFaceContainer &origin)
+{
+  for (uint32_t faceId = 0; faceId < origin.limit (); faceId ++)
+    {
+      if (origin.has (faceId))
+        (*this) [faceId].unsatisfied ()++;
+    }
+}
+
+LoadStatsFaceContainer &
+LoadStatsFaceContainer::operator += (const LoadStatsFaceContainer &stats)
+{
+  for (uint32_t faceId = 0; faceId < stats.limit (); faceId ++)
+    {
+      if (stats.has (faceId))
+        (*this) [faceId] += stats.m_faces [faceId];
+    }
+  return *this;
+}
+
+bool
+LoadStatsFaceContainer::IsZero () const
+{
+  for (uint32_t faceId = 0; faceId < m_faces.size (); faceId ++)
+    {
+      if (m_present [faceId] && !m_faces [faceId].IsZero ())
+        return false;
+    }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void
+LoadStatsNode::Step (uint32_t steps)
+{
+  NS_LOG_FUNCTION (this << steps);
+  
+  m_pit.Step (steps);
+  m_incoming.Step (steps);
+  m_outgoing.Step (steps);
+}
+
+void
+LoadStatsNode::Sync (uint32_t epoch)
+{
+  if (m_epoch >= epoch)
+    return;
+
+  Step (epoch - m_epoch);
+  m_epoch = epoch;
+}
+
 void
 LoadStatsNode::NewPitEntry ()
 {
@@ -75,41 +145,29 @@ LoadStatsNode::AddOutgoing (ns3::Ptr<Face> face)
 void
 LoadStatsNode::Satisfy ()
 {
-  m_pit.satisfied ()++;
-  
-  for (stats_container::iterator item = m_incoming.begin ();
-       item != m_incoming.end ();
-       item ++)
-    {
-      item->second.satisfied ()++;
-    }
-
-  for (stats_container::iterator item = m_outgoing.begin ();
-       item != m_outgoing.end ();
-       item ++)
-    {
-      item->second.satisfied ()++;
-    }
+  Satisfy (*this);
 }
 
 void
 LoadStatsNode::Timeout ()
 {
-  m_pit.unsatisfied ()++;
-  
-  for (stats_container::iterator item = m_incoming.begin ();
-       item != m_incoming.end ();
-       item ++)
-    {
-      item->second.unsatisfied ()++;
-    }
+  Timeout (*this);
+}
 
-  for (stats_container::iterator item = m_outgoing.begin ();
-       item != m_outgoing.end ();
-       item ++)
-    {
-      item->second.unsatisfied ()++;
-    }
+void
+LoadStatsNode::Satisfy (const LoadStatsNode &origin)
+{
+  m_pit.satisfied ()++;
+  m_incoming.Satisfy (origin.m_incoming);
+  m_outgoing.Satisfy (origin.m_outgoing);
+}
+
+void
+LoadStatsNode::Timeout (const LoadStatsNode &origin)
+{
+  m_pit.unsatisfied ()++;
+  m_incoming.Timeout (origin.m_incoming);
+  m_outgoing.Timeout (origin.m_outgoing);
 }
 
 void
@@ -133,22 +191,8 @@ LoadStatsNode::operator += (const LoadStatsNode &stats)
   NS_LOG_FUNCTION (this << &stats);
   
   m_pit += stats.m_pit;
-  
-  // aggregate incoming
-  for (stats_container::const_iterator item = stats.m_incoming.begin ();
-       item != stats.m_incoming.end ();
-       item ++)
-    {
-      m_incoming [item->first] += item->second;
-    }
-  
-  // aggregate outgoing
-  for (stats_container::const_iterator item = stats.m_outgoing.begin ();
-       item != stats.m_outgoing.end ();
-       item ++)
-    {
-      m_outgoing [item->first] += item->second;
-    }
+  m_incoming += stats.m_incoming;
+  m_outgoing += stats.m_outgoing;
 
   return *this;
 }
@@ -156,32 +200,7 @@ LoadStatsNode::operator += (const LoadStatsNode &stats)
 bool
 LoadStatsNode::IsZero () const
 {
-  bool zero = true;
-  for (stats_container::const_iterator item = m_incoming.begin ();
-       item != m_incoming.end ();
-       item ++)
-    {
-      zero &= item->second.IsZero ();
-    }
-
-  for (stats_container::const_iterator item = m_outgoing.begin ();
-       item != m_outgoing.end ();
-       item ++)
-    {
-      zero &= item->second.IsZero ();
-    }
-
-//  std::for_each (m_incoming.begin (), m_incoming.end (),
-//                 zero &= ll::bind (&LoadStatsFace::IsZero,
-//                                   ll::bind (&stats_container::value_type::second, ll::_1)));
-//
-//  std::for_each (m_outgoing.begin (), m_outgoing.end (),
-//                 zero &= ll::bind (&LoadStatsFace::IsZero,
-//                                   ll::bind (&stats_container::value_type::second, ll::_1)));
-  
-  zero &= m_pit.IsZero ();
-  
-  return zero;  
+  return m_pit.IsZero () && m_incoming.IsZero () && m_outgoing.IsZero ();
 }
 
 
@@ -189,8 +208,8 @@ void
 LoadStatsNode::RemoveFace (ns3::Ptr<Face> face)
 {
   NS_LOG_FUNCTION (this);
-  m_incoming.erase (face);
-  m_outgoing.erase (face);
+  m_incoming.erase (face->GetId ());
+  m_outgoing.erase (face->GetId ());
 }
 
 bool
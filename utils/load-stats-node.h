@@ -22,8 +22,9 @@
 #define LOAD_STATS_NODE_H
 
 #include "load-stats-face.h"
-#include <map>
+#include <vector>
 #include "ns3/ptr.h"
+#include "ns3/fatal-error.h"
 
 namespace ns3 {
 namespace ndn {
@@ -33,18 +34,155 @@ class Face;
 namespace ndnSIM
 {
 
+/**
+ * @brief Dense container of per-face stats, indexed by face ID
+ *
+ * Face IDs are assigned sequentially by L3Protocol::AddFace, so a vector indexed
+ * by ID is small and avoids map lookups (and Ptr<Face> refcounting) on every
+ * event
+ */
+class LoadStatsFaceContainer
+{
+public:
+  LoadStatsFaceContainer () : m_size (0) {}
+
+  /**
+   * @brief Get (create if necessary) stats for the face with the specified ID
+   *
+   * It is a fatal error to pass ID of the face that has not been added to L3Protocol
+   */
+  inline LoadStatsFace &
+  operator [] (uint32_t faceId);
+
+  LoadStatsFace &
+  operator [] (ns3::Ptr<Face> face);
+
+  /**
+   * @brief Find stats for the face with the specified ID
+   * @returns 0 if there are no stats for the face
+   */
+  inline const LoadStatsFace *
+  find (uint32_t faceId) const;
+
+  const LoadStatsFace *
+  find (ns3::Ptr<Face> face) const;
+
+  /**
+   * @brief Check if there are stats for the face with the specified ID
+   */
+  inline bool
+  has (uint32_t faceId) const;
+
+  void
+  erase (uint32_t faceId);
+
+  /**
+   * @brief Number of faces that have stats
+   */
+  inline size_t
+  size () const;
+
+  /**
+   * @brief Upper bound on face IDs present in the container (all IDs are less than this)
+   */
+  inline uint32_t
+  limit () const;
+
+  void
+  Step (uint32_t steps);
+
+  /**
+   * @brief Increment satisfied counter for every face that is present in origin
+   */
+  void
+  Satisfy (const LoadStatsFaceContainer &origin);
+
+  /**
+   * @brief Increment unsatisfied counter for every face that is present in origin
+   */
+  void
+  Timeout (const LoadStatsFaceContainer &origin);
+
+  LoadStatsFaceContainer &
+  operator += (const LoadStatsFaceContainer &stats);
+
+  bool
+  IsZero () const;
+
+private:
+  std::vector<LoadStatsFace> m_faces;
+  std::vector<bool> m_present;
+  size_t m_size;
+};
+
+inline LoadStatsFace &
+LoadStatsFaceContainer::operator [] (uint32_t faceId)
+{
+  if (faceId == static_cast<uint32_t> (-1))
+    NS_FATAL_ERROR ("Face has no ID, it should be added to L3Protocol before its stats are updated");
+
+  if (faceId >= m_faces.size ())
+    {
+      m_faces.resize (faceId + 1);
+      m_present.resize (faceId + 1, false);
+    }
+
+  if (!m_present [faceId])
+    {
+      m_present [faceId] = true;
+      m_size ++;
+    }
+  return m_faces [faceId];
+}
+
+inline const LoadStatsFace *
+LoadStatsFaceContainer::find (uint32_t faceId) const
+{
+  if (!has (faceId))
+    return 0;
+
+  return &m_faces [faceId];
+}
+
+inline bool
+LoadStatsFaceContainer::has (uint32_t faceId) const
+{
+  return faceId < m_present.size () && m_present [faceId];
+}
+
+inline size_t
+LoadStatsFaceContainer::size () const
+{
+  return m_size;
+}
+
+inline uint32_t
+LoadStatsFaceContainer::limit () const
+{
+  return m_faces.size ();
+}
+
 // this thing is actually put into a tree node, associated with each "name entry"
 
 class LoadStatsNode
 {
 public:
-  typedef std::map< ns3::Ptr<Face>, LoadStatsFace > stats_container;
+  typedef LoadStatsFaceContainer stats_container;
 
-  LoadStatsNode () {}
-  LoadStatsNode (const LoadStatsNode &) {}
+  LoadStatsNode () : m_epoch (0) {}
+  LoadStatsNode (const LoadStatsNode &) : m_epoch (0) {}
 
   void
-  Step ();
+  Step (uint32_t steps = 1);
+
+  /**
+   * @brief Lazily bring all averages up to date with the specified epoch
+   *
+   * Averages are not decayed while nobody looks at the node. When the node is
+   * accessed again, all intervals missed since the last access are applied at once
+   */
+  void
+  Sync (uint32_t epoch);
 
   /**
    * Increment face-independent counter
@@ -76,6 +214,22 @@ public:
   void
   Timeout ();
 
+  /**
+   * @brief Increment satisfied counters for all faces known to the origin node
+   *
+   * Used to propagate Satisfy event from a child node to its parents
+   */
+  void
+  Satisfy (const LoadStatsNode &origin);
+
+  /**
+   * @brief Increment unsatisfied counters for all faces known to the origin node
+   *
+   * Used to propagate Timeout event from a child node to its parents
+   */
+  void
+  Timeout (const LoadStatsNode &origin);
+
   /**
    * Increment counter for Tx amount
    */
@@ -127,6 +281,8 @@ private:
   stats_container m_incoming;
   stats_container m_outgoing;
 
+  uint32_t m_epoch; ///< \brief Epoch to which all averages have been decayed
+
   friend std::ostream&
   operator << (std::ostream &os, const LoadStatsNode &node);
 };
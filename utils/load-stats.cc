@@ -46,16 +46,28 @@ LoadStats::LoadStats ()
 }
 
 void
-LoadStats::Step ()
+LoadStats::Step (uint32_t steps)
 {
   // NS_LOG_FUNCTION (this);
 
+  if (steps == 0 ||
+      (counter_ == 0 && avg1_ == 0 && avg2_ == 0 && avg3_ == 0))
+    return;
+
   // do magic
   avg1_ = EXP_1 * avg1_ + (1 - EXP_1) * counter_;
   avg2_ = EXP_2 * avg2_ + (1 - EXP_2) * counter_;
   avg3_ = EXP_3 * avg3_ + (1 - EXP_3) * counter_;
 
   counter_ = 0;
+
+  if (steps > 1)
+    {
+      // the rest of intervals had no events, so averages just decay
+      avg1_ *= pow (EXP_1, static_cast<double> (steps - 1));
+      avg2_ *= pow (EXP_2, static_cast<double> (steps - 1));
+      avg3_ *= pow (EXP_3, static_cast<double> (steps - 1));
+    }
 }
 
 LoadStats &
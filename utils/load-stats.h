@@ -36,9 +36,15 @@ public:
   static const double PRECISION;
 
   LoadStats ();
-  
+
+  /**
+   * @brief Close the current interval and decay averages
+   * @param steps number of elapsed intervals; the accumulated counter is
+   *              attributed to the first one, the remaining ones decay averages
+   *              as if no events happened
+   */
   void
-  Step ();
+  Step (uint32_t steps = 1);
 
   // void
   // Increment (uint32_t amount);
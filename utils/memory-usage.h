@@ -0,0 +1,114 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_MEMORY_USAGE_H
+#define NDN_MEMORY_USAGE_H
+
+#include <string>
+#include <list>
+#include <set>
+#include <cstddef>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Estimate of memory occupied by a forwarding table (PIT, FIB, or CS)
+ *
+ * Numbers are estimates of heap usage: sizes of the objects themselves are exact,
+ * while per-node overhead of standard and boost containers assumes a typical 64-bit
+ * libstdc++/boost layout and ignores allocator padding.
+ */
+struct MemoryUsage
+{
+  MemoryUsage ()
+    : m_index (0)
+    , m_entries (0)
+    , m_names (0)
+  {
+  }
+
+  size_t m_index;   ///< @brief Trie nodes, hash bucket arrays, and name components used as trie keys
+  size_t m_entries; ///< @brief Table entries with their own containers (nonces, faces, cached packets)
+  size_t m_names;   ///< @brief Name objects referenced by the table entries
+
+  /**
+   * @brief Get total number of bytes
+   */
+  inline size_t
+  GetTotal () const
+  {
+    return m_index + m_entries + m_names;
+  }
+
+  inline MemoryUsage &
+  operator += (const MemoryUsage &other)
+  {
+    m_index += other.m_index;
+    m_entries += other.m_entries;
+    m_names += other.m_names;
+    return *this;
+  }
+};
+
+/**
+ * @brief Number of heap bytes owned by the string (zero if short string optimization applies)
+ */
+inline size_t
+DynamicSize (const std::string &str)
+{
+  const char *data = str.data ();
+  const char *self = reinterpret_cast<const char*> (&str);
+  if (data >= self && data < self + sizeof (std::string))
+    return 0; // stored in-place
+
+  return str.capacity () + 1;
+}
+
+/**
+ * @brief Number of heap bytes owned by the list of strings (e.g., name components)
+ */
+inline size_t
+DynamicSize (const std::list<std::string> &list)
+{
+  size_t size = list.size () * (2 * sizeof (void*) + sizeof (std::string));
+  for (std::list<std::string>::const_iterator item = list.begin ();
+       item != list.end ();
+       item++)
+    {
+      size += DynamicSize (*item);
+    }
+  return size;
+}
+
+/**
+ * @brief Number of heap bytes owned by the set (elements are assumed not to own any heap memory)
+ */
+template<class T, class Compare>
+inline size_t
+DynamicSize (const std::set<T, Compare> &set)
+{
+  // red-black tree node: color, parent, left, and right links, followed by the value
+  return set.size () * (4 * sizeof (void*) + sizeof (T));
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MEMORY_USAGE_H
@@ -0,0 +1,248 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcap-trace-writer.h"
+
+#include "ns3/packet.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+
+#include <algorithm>
+#include <sched.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PcapTraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+static const uint32_t PCAP_MAGIC = 0xa1b2c3d4;
+static const uint16_t PCAP_VERSION_MAJOR = 2;
+static const uint16_t PCAP_VERSION_MINOR = 4;
+
+template<class T>
+static void
+Append (std::vector<char> &buffer, const T &value)
+{
+  const char *data = reinterpret_cast<const char*> (&value);
+  buffer.insert (buffer.end (), data, data + sizeof (T));
+}
+
+PcapTraceWriter::PcapTraceWriter (uint32_t snapLen, uint32_t dataLinkType,
+                                  size_t blockSize, size_t maxPendingBlocks)
+  : m_snapLen (snapLen)
+  , m_dataLinkType (dataLinkType)
+  , m_blockSize (blockSize)
+  , m_pending (maxPendingBlocks)
+  , m_free (maxPendingBlocks)
+  , m_stop (false)
+  , m_closed (false)
+  , m_records (0)
+{
+}
+
+PcapTraceWriter::~PcapTraceWriter ()
+{
+  Close ();
+}
+
+uint32_t
+PcapTraceWriter::AddFile (const std::string &file)
+{
+  NS_ASSERT_MSG (!m_closed, "PcapTraceWriter is already closed");
+
+  File item;
+  item.m_os = new std::ofstream (file.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  item.m_block = 0;
+  if (!item.m_os->is_open ())
+    {
+      delete item.m_os;
+      NS_FATAL_ERROR ("Cannot open pcap file " << file);
+    }
+
+  // the writer thread has not seen this stream yet
+  std::vector<char> header;
+  Append (header, PCAP_MAGIC);
+  Append (header, PCAP_VERSION_MAJOR);
+  Append (header, PCAP_VERSION_MINOR);
+  Append (header, static_cast<int32_t> (0)); // thiszone
+  Append (header, static_cast<uint32_t> (0)); // sigfigs
+  Append (header, m_snapLen);
+  Append (header, m_dataLinkType);
+  item.m_os->write (&header [0], header.size ());
+
+  m_files.push_back (item);
+
+  if (m_thread == 0)
+    {
+      m_thread = Create<SystemThread> (MakeCallback (&PcapTraceWriter::WriterThread, this));
+      m_thread->Start ();
+    }
+
+  return m_files.size () - 1;
+}
+
+void
+PcapTraceWriter::Write (uint32_t fileId, const Time &time, Ptr<const Packet> packet)
+{
+  NS_ASSERT_MSG (!m_closed, "PcapTraceWriter is already closed");
+  NS_ASSERT (fileId < m_files.size ());
+
+  File &file = m_files [fileId];
+  uint32_t size = packet->GetSize ();
+  uint32_t captured = std::min (size, m_snapLen);
+
+  if (file.m_block != 0 && file.m_block->size () + 4 * sizeof (uint32_t) + captured > m_blockSize)
+    Submit (file);
+  if (file.m_block == 0)
+    file.m_block = GetFreeBlock ();
+
+  std::vector<char> &block = *file.m_block;
+  int64_t us = time.GetMicroSeconds ();
+  Append (block, static_cast<uint32_t> (us / 1000000));
+  Append (block, static_cast<uint32_t> (us % 1000000));
+  Append (block, captured);
+  Append (block, size);
+
+  size_t offset = block.size ();
+  block.resize (offset + captured);
+  if (captured > 0)
+    packet->CopyData (reinterpret_cast<uint8_t*> (&block [offset]), captured);
+
+  m_records ++;
+}
+
+void
+PcapTraceWriter::Flush ()
+{
+  for (std::vector<File>::iterator file = m_files.begin (); file != m_files.end (); file++)
+    {
+      Submit (*file);
+    }
+}
+
+void
+PcapTraceWriter::Close ()
+{
+  if (m_closed)
+    return;
+
+  if (m_thread != 0)
+    {
+      Flush ();
+
+      m_stop = true;
+      __sync_synchronize ();
+      m_wakeup.SetCondition (true);
+      m_wakeup.Signal ();
+      m_thread->Join ();
+      m_thread = 0;
+    }
+
+  for (std::vector<File>::iterator file = m_files.begin (); file != m_files.end (); file++)
+    {
+      file->m_os->close ();
+      delete file->m_os;
+      delete file->m_block;
+    }
+
+  std::vector<char> *block;
+  while (m_free.pop (block))
+    delete block;
+
+  m_closed = true;
+
+  NS_LOG_DEBUG (m_files.size () << " files, " << m_records << " records");
+}
+
+uint64_t
+PcapTraceWriter::GetRecordCount () const
+{
+  return m_records;
+}
+
+uint32_t
+PcapTraceWriter::GetSnapLen () const
+{
+  return m_snapLen;
+}
+
+std::vector<char> *
+PcapTraceWriter::GetFreeBlock ()
+{
+  std::vector<char> *block;
+  if (m_free.pop (block))
+    return block;
+
+  block = new std::vector<char> ();
+  block->reserve (m_blockSize);
+  return block;
+}
+
+void
+PcapTraceWriter::Submit (File &file)
+{
+  if (file.m_block == 0 || file.m_block->empty ())
+    return;
+
+  Block block;
+  block.m_os = file.m_os;
+  block.m_data = file.m_block;
+  while (!m_pending.push (block))
+    {
+      // writer thread is behind, wake it up and give it a chance
+      m_wakeup.SetCondition (true);
+      m_wakeup.Signal ();
+      sched_yield ();
+    }
+  file.m_block = 0;
+
+  m_wakeup.SetCondition (true);
+  m_wakeup.Signal ();
+}
+
+void
+PcapTraceWriter::WriterThread ()
+{
+  Block block;
+  while (true)
+    {
+      // TimedWait does not reset the condition (only Wait does).  Reset it before draining, so
+      // that anything submitted from now on wakes the thread again, and otherwise the thread sleeps
+      m_wakeup.SetCondition (false);
+
+      bool stop = m_stop;
+      __sync_synchronize ();
+
+      while (m_pending.pop (block))
+        {
+          block.m_os->write (&(*block.m_data) [0], block.m_data->size ());
+          block.m_data->clear ();
+          if (!m_free.push (block.m_data))
+            delete block.m_data;
+        }
+
+      if (stop)
+        break;
+
+      m_wakeup.TimedWait (10000000); // 10ms
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
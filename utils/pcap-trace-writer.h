@@ -0,0 +1,156 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_PCAP_TRACE_WRITER_H
+#define NDN_PCAP_TRACE_WRITER_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-condition.h"
+
+#include "spsc-queue.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdint.h>
+
+namespace ns3 {
+
+class Packet;
+
+namespace ndn {
+
+/**
+ * @brief Writer of pcap files with buffering and flushing on a background thread
+ *
+ * Packets are appended to a large per-file block on the simulation thread (only
+ * pcap record header and at most snapLen bytes of the packet are copied).  Full
+ * blocks are handed over to a background writer thread through a lock-free
+ * single-producer single-consumer queue and written with one call, and written
+ * blocks are returned for reuse the same way.  One writer (and one thread) can
+ * serve any number of files.
+ *
+ * Usage:
+ *
+ *     Ptr<PcapTraceWriter> writer = Create<PcapTraceWriter> ();
+ *     uint32_t file = writer->AddFile ("trace.pcap");
+ *     ...
+ *     writer->Write (file, Simulator::Now (), packet);
+ *
+ * Files are complete only after Close (or destruction of the writer)
+ */
+class PcapTraceWriter : public SimpleRefCount<PcapTraceWriter>
+{
+public:
+  /**
+   * @brief Create writer
+   * @param snapLen maximum number of bytes of each packet saved in the file
+   * @param dataLinkType data link type in the pcap file header (9 is DLT_PPP, same as in PcapHelper)
+   * @param blockSize size of the buffer block of each file
+   * @param maxPendingBlocks maximum number of full blocks pending to be written
+   */
+  PcapTraceWriter (uint32_t snapLen = 65535, uint32_t dataLinkType = 9,
+                   size_t blockSize = 1024 * 1024, size_t maxPendingBlocks = 64);
+
+  /**
+   * @brief Flushes all pending records and closes all files
+   */
+  ~PcapTraceWriter ();
+
+  /**
+   * @brief Create (truncate) pcap file
+   * @returns ID of the file to be used in Write
+   */
+  uint32_t
+  AddFile (const std::string &file);
+
+  /**
+   * @brief Append packet to the file
+   *
+   * Blocks only when the writer thread falls behind and maxPendingBlocks are waiting
+   */
+  void
+  Write (uint32_t file, const Time &time, Ptr<const Packet> packet);
+
+  /**
+   * @brief Hand over all partially filled blocks to the writer thread
+   */
+  void
+  Flush ();
+
+  /**
+   * @brief Write all pending records, stop the writer thread and close all files
+   */
+  void
+  Close ();
+
+  /**
+   * @brief Get number of packets written so far
+   */
+  uint64_t
+  GetRecordCount () const;
+
+  uint32_t
+  GetSnapLen () const;
+
+private:
+  struct Block
+  {
+    std::ofstream *m_os;
+    std::vector<char> *m_data;
+  };
+
+  struct File
+  {
+    std::ofstream *m_os;        ///< \brief owned, used only by the writer thread after AddFile
+    std::vector<char> *m_block; ///< \brief block being filled, 0 if none
+  };
+
+  std::vector<char> *
+  GetFreeBlock ();
+
+  void
+  Submit (File &file);
+
+  void
+  WriterThread ();
+
+private:
+  uint32_t m_snapLen;
+  uint32_t m_dataLinkType;
+  size_t m_blockSize;
+
+  std::vector<File> m_files; ///< \brief simulation thread only
+
+  ndnSIM::spsc_queue<Block> m_pending;             ///< \brief full blocks, simulation thread -> writer thread
+  ndnSIM::spsc_queue< std::vector<char>* > m_free; ///< \brief written blocks, writer thread -> simulation thread
+
+  Ptr<SystemThread> m_thread;
+  SystemCondition m_wakeup;
+  volatile bool m_stop;
+  bool m_closed;
+  uint64_t m_records;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PCAP_TRACE_WRITER_H
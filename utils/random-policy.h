@@ -23,8 +23,12 @@
 
 #include "ns3/random-variable.h"
 
+#include "detail/functor-hook.h"
+
 #include <boost/intrusive/options.hpp>
-#include <boost/intrusive/set.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -32,17 +36,24 @@ namespace ndnSIM {
 
 /**
  * @brief Traits for random replacement policy
+ *
+ * Entries are kept in a dense vector and each entry remembers its position in the hook,
+ * so insert, erase, and eviction of a random entry are O(1) (erase moves the last
+ * entry into the freed slot).  When the policy is full, the new entry either replaces
+ * a uniformly chosen existing entry or, with probability 1/(size+1), is rejected
  */
 struct random_policy_traits
 {
-  struct policy_hook_type : public boost::intrusive::set_member_hook<> { uint32_t randomOrder; };
+  struct policy_hook_type
+  {
+    policy_hook_type () : index (0) { }
+    size_t index; ///< @brief position of the entry in the vector of the policy
+  };
 
   template<class Container>
   struct container_hook
   {
-    typedef boost::intrusive::member_hook< Container,
-                                           policy_hook_type,
-                                           &Container::policy_hook_ > type;
+    typedef boost::intrusive::function_hook< detail::MemberHook<Container, policy_hook_type> > type;
   };
 
   template<class Base,
@@ -50,40 +61,24 @@ struct random_policy_traits
            class Hook>
   struct policy 
   {
-    static uint32_t& get_order (typename Container::iterator item)
-    {
-      return static_cast<typename policy_container::value_traits::hook_type*>
-        (policy_container::value_traits::to_node_ptr(*item))->randomOrder;
-    }
-      
-    static const uint32_t& get_order (typename Container::const_iterator item)
+    typedef typename detail::HookFunctor<Hook>::type functor;
+
+    static size_t& get_index (typename Container::iterator item)
     {
-      return static_cast<const typename policy_container::value_traits::hook_type*>
-        (policy_container::value_traits::to_node_ptr(*item))->randomOrder;
+      return functor::to_hook_ptr (*item)->index;
     }
-    
-    template<class Key>
-    struct MemberHookLess
-    {
-      bool operator () (const Key &a, const Key &b) const
-      {
-        return get_order (&a) < get_order (&b);
-      }
-    };
 
-    typedef boost::intrusive::multiset< Container,
-                                   boost::intrusive::compare< MemberHookLess< Container > >,
-                                   Hook > policy_container;
-    
-    // could be just typedef
-    class type : public policy_container
+    class type
     {
     public:
       typedef Container parent_trie;
+      typedef std::vector<typename parent_trie::iterator> items_container;
+
+      typedef boost::indirect_iterator<typename items_container::iterator> iterator;
+      typedef boost::indirect_iterator<typename items_container::const_iterator, const parent_trie> const_iterator;
 
       type (Base &base)
         : base_ (base)
-        , u_rand (0, std::numeric_limits<uint32_t>::max ())
         , max_size_ (100)
       {
       }
@@ -97,24 +92,23 @@ struct random_policy_traits
       inline bool
       insert (typename parent_trie::iterator item)
       {
-        get_order (item) = u_rand.GetValue ();
-
-        if (max_size_ != 0 && policy_container::size () >= max_size_)
+        if (max_size_ != 0 && items_.size () >= max_size_)
           {
-            if (MemberHookLess<Container>() (*item, *policy_container::begin ()))
+            uint32_t victim = u_rand.GetInteger (0, items_.size ());
+            if (victim == items_.size ())
               {
-                // std::cout << "Cannot add. Signaling fail\n";
                 // just return false. Indicating that insert "failed"
                 return false;
               }
             else
               {
                 // removing some random element
-                base_.erase (&(*policy_container::begin ()));
+                base_.erase (items_ [victim]);
               }
           }
 
-        policy_container::insert (*item);
+        get_index (item) = items_.size ();
+        items_.push_back (item);
         return true;
       }
   
@@ -127,13 +121,46 @@ struct random_policy_traits
       inline void
       erase (typename parent_trie::iterator item)
       {
-        policy_container::erase (policy_container::s_iterator_to (*item));
+        size_t index = get_index (item);
+        items_ [index] = items_.back ();
+        get_index (items_ [index]) = index;
+        items_.pop_back ();
       }
 
       inline void
       clear ()
       {
-        policy_container::clear ();
+        items_.clear ();
+      }
+
+      inline size_t
+      size () const
+      {
+        return items_.size ();
+      }
+
+      inline iterator
+      begin ()
+      {
+        return iterator (items_.begin ());
+      }
+
+      inline iterator
+      end ()
+      {
+        return iterator (items_.end ());
+      }
+
+      inline const_iterator
+      begin () const
+      {
+        return const_iterator (items_.begin ());
+      }
+
+      inline const_iterator
+      end () const
+      {
+        return const_iterator (items_.end ());
       }
 
       inline void
@@ -153,6 +180,7 @@ struct random_policy_traits
       
     private:
       Base &base_;
+      items_container items_;
       ns3::UniformVariable u_rand;
       size_t max_size_;
     };
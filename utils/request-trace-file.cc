@@ -0,0 +1,158 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "request-trace-file.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.RequestTraceFile");
+
+namespace ns3 {
+namespace ndn {
+
+std::map<std::string, RequestTraceFile*> RequestTraceFile::s_files;
+
+Ptr<RequestTraceFile>
+RequestTraceFile::Open (const std::string &file)
+{
+  std::map<std::string, RequestTraceFile*>::iterator existing = s_files.find (file);
+  if (existing != s_files.end ())
+    return existing->second;
+
+  // constructor registers itself in s_files
+  return Ptr<RequestTraceFile> (new RequestTraceFile (file), false);
+}
+
+RequestTraceFile::RequestTraceFile (const std::string &file)
+  : m_file (file)
+  , m_data (0)
+  , m_size (0)
+{
+  int fd = open (file.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_FATAL_ERROR ("Cannot open request trace file " << file);
+    }
+
+  struct stat st;
+  if (fstat (fd, &st) != 0 || static_cast<uint64_t> (st.st_size) < sizeof (RequestTraceFormat::Header))
+    {
+      close (fd);
+      NS_FATAL_ERROR ("Request trace file " << file << " is truncated");
+    }
+  m_size = st.st_size;
+
+  void *data = mmap (0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd); // mapping stays valid
+  if (data == MAP_FAILED)
+    {
+      NS_FATAL_ERROR ("Cannot map request trace file " << file);
+    }
+  m_data = static_cast<const char*> (data);
+  madvise (data, m_size, MADV_SEQUENTIAL);
+
+  const RequestTraceFormat::Header *header = reinterpret_cast<const RequestTraceFormat::Header*> (m_data);
+  if (std::memcmp (header->magic, RequestTraceFormat::MAGIC, sizeof (RequestTraceFormat::MAGIC)) != 0)
+    {
+      NS_FATAL_ERROR ("File " << file << " is not a request trace");
+    }
+
+  m_recordCount = header->recordCount;
+  m_nameCount = header->nameCount;
+
+  // written this way to avoid overflows on garbage counts and offsets
+  if (header->recordsOffset > m_size ||
+      m_recordCount > (m_size - header->recordsOffset) / sizeof (Record) ||
+      header->namesOffset > m_size ||
+      m_nameCount >= (m_size - header->namesOffset) / sizeof (uint64_t))
+    {
+      NS_FATAL_ERROR ("Request trace file " << file << " is truncated");
+    }
+  if (header->recordsOffset % sizeof (uint64_t) != 0 ||
+      header->namesOffset % sizeof (uint64_t) != 0)
+    {
+      NS_FATAL_ERROR ("Request trace file " << file << " is corrupt (misaligned tables)");
+    }
+
+  m_records = reinterpret_cast<const Record*> (m_data + header->recordsOffset);
+  m_nameOffsets = reinterpret_cast<const uint64_t*> (m_data + header->namesOffset);
+  m_nameData = m_data + header->namesOffset + (m_nameCount + 1) * sizeof (uint64_t);
+
+  // names and records are later used without any checks
+  uint64_t nameDataSize = m_size - (m_nameData - m_data);
+  for (uint64_t name = 0; name < m_nameCount; name++)
+    {
+      if (m_nameOffsets[name] > m_nameOffsets[name + 1] || m_nameOffsets[name + 1] > nameDataSize)
+        {
+          NS_FATAL_ERROR ("Request trace file " << file << " is corrupt (invalid offset of name " << name << ")");
+        }
+    }
+  for (uint64_t record = 0; record < m_recordCount; record++)
+    {
+      if (m_records[record].name >= m_nameCount)
+        {
+          NS_FATAL_ERROR ("Request trace file " << file << " is corrupt (invalid name of record " << record << ")");
+        }
+    }
+
+  NS_LOG_DEBUG ("Mapped " << file << ": " << m_recordCount << " records, " << m_nameCount << " names");
+  s_files[m_file] = this;
+}
+
+RequestTraceFile::~RequestTraceFile ()
+{
+  s_files.erase (m_file);
+  munmap (const_cast<char*> (m_data), m_size);
+}
+
+std::string
+RequestTraceFile::GetName (uint32_t name) const
+{
+  NS_ASSERT (name < m_nameCount);
+  return std::string (m_nameData + m_nameOffsets[name], m_nameData + m_nameOffsets[name + 1]);
+}
+
+uint64_t
+RequestTraceFile::LowerBound (uint64_t time, uint64_t first, uint64_t last) const
+{
+  while (first < last)
+    {
+      uint64_t middle = first + (last - first) / 2;
+      if (m_records[middle].time < time)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+  return first;
+}
+
+const std::string &
+RequestTraceFile::GetFile () const
+{
+  return m_file;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,119 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_REQUEST_TRACE_FILE_H
+#define NDN_REQUEST_TRACE_FILE_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+
+#include "request-trace-format.h"
+
+#include <string>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Read-only memory-mapped request trace (see RequestTraceFormat)
+ *
+ * Records are accessed directly in the mapping, so the memory footprint does not depend on
+ * the trace length (pages are loaded and evicted by the OS).  All users of the same file
+ * share one mapping
+ */
+class RequestTraceFile : public SimpleRefCount<RequestTraceFile>
+{
+public:
+  typedef RequestTraceFormat::Record Record;
+
+  /**
+   * @brief Get mapping of the file, shared with other users of the same file
+   *
+   * Terminates simulation if file cannot be opened, is not a request trace, or is truncated
+   * or corrupt (all offsets and name indices are checked once, when the file is mapped)
+   */
+  static Ptr<RequestTraceFile>
+  Open (const std::string &file);
+
+  ~RequestTraceFile ();
+
+  /**
+   * @brief Number of records in the trace
+   */
+  inline uint64_t
+  GetRecordCount () const;
+
+  /**
+   * @brief Get record (no bounds checking)
+   */
+  inline const Record &
+  GetRecord (uint64_t index) const;
+
+  /**
+   * @brief Get name (prefix) from the name table
+   */
+  std::string
+  GetName (uint32_t name) const;
+
+  /**
+   * @brief Get index of the first record in [first, last) with time not less than the specified value
+   */
+  uint64_t
+  LowerBound (uint64_t time, uint64_t first, uint64_t last) const;
+
+  /**
+   * @brief Get name of the mapped file
+   */
+  const std::string &
+  GetFile () const;
+
+private:
+  RequestTraceFile (const std::string &file);
+
+private:
+  std::string m_file;
+  const char *m_data;
+  uint64_t m_size;
+
+  const Record   *m_records;
+  uint64_t        m_recordCount;
+  const uint64_t *m_nameOffsets;
+  const char     *m_nameData;
+  uint64_t        m_nameCount;
+
+  // raw pointers, entries are removed by the destructor
+  static std::map<std::string, RequestTraceFile*> s_files;
+};
+
+inline uint64_t
+RequestTraceFile::GetRecordCount () const
+{
+  return m_recordCount;
+}
+
+inline const RequestTraceFile::Record &
+RequestTraceFile::GetRecord (uint64_t index) const
+{
+  return m_records[index];
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_FILE_H
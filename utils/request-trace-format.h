@@ -0,0 +1,73 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_REQUEST_TRACE_FORMAT_H
+#define NDN_REQUEST_TRACE_FORMAT_H
+
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Layout of binary request traces replayed by ConsumerTrace
+ *
+ * The file is designed to be memory-mapped and used in place, without any parsing.
+ * All integers are in host byte order.
+ *
+ *  - Header (see below), at offset 0
+ *  - Record[recordCount], at header.recordsOffset, sorted by time
+ *  - uint64_t nameOffsets[nameCount + 1], at header.namesOffset.  Name i is the string
+ *    [nameOffsets[i], nameOffsets[i+1]) of the name data, which immediately follows the offsets
+ *
+ * Use tools/ndn-request-trace-convert to create the file from a text trace
+ */
+namespace RequestTraceFormat {
+
+static const char MAGIC[8] = { 'N', 'D', 'N', 'R', 'E', 'Q', '0', '1' };
+
+/**
+ * @brief Value of Record::seq meaning that the name has no sequence number component
+ */
+static const uint32_t NO_SEQ = 0xFFFFFFFF;
+
+struct Header
+{
+  char     magic[8];
+  uint64_t recordCount;
+  uint64_t recordsOffset;
+  uint64_t nameCount;
+  uint64_t namesOffset;
+};
+
+/**
+ * @brief One request: Interest for the name (followed by seq, unless it is NO_SEQ) at the specified time
+ */
+struct Record
+{
+  uint64_t time; ///< @brief time in nanoseconds since the beginning of the trace
+  uint32_t name; ///< @brief index of the name (prefix) in the name table
+  uint32_t seq;  ///< @brief sequence number component, or NO_SEQ
+};
+
+} // namespace RequestTraceFormat
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_FORMAT_H
@@ -0,0 +1,77 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "retx-timer.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+namespace ndn {
+
+RetxTimer::RetxTimer ()
+{
+}
+
+RetxTimer::~RetxTimer ()
+{
+  Cancel ();
+}
+
+void
+RetxTimer::SetFunction (const Callback<void> &function)
+{
+  m_function = function;
+}
+
+void
+RetxTimer::Arm (const Time &deadline)
+{
+  Time now = Simulator::Now ();
+  Time expire = Max (now, deadline);
+
+  if (m_event.IsRunning ())
+    {
+      if (m_deadline <= expire)
+        return; // pending event fires no later than needed
+
+      Simulator::Remove (m_event);
+    }
+
+  m_deadline = expire;
+  m_event = Simulator::Schedule (expire - now, &RetxTimer::Expire, this);
+}
+
+void
+RetxTimer::Cancel ()
+{
+  Simulator::Cancel (m_event);
+}
+
+bool
+RetxTimer::IsRunning () const
+{
+  return m_event.IsRunning ();
+}
+
+void
+RetxTimer::Expire ()
+{
+  m_function ();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,82 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_RETX_TIMER_H
+#define NDN_RETX_TIMER_H
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Single event that checks retransmission timeouts no later than the earliest deadline
+ *
+ * The owner calls Arm with the earliest expiration time of its outstanding Interests each time
+ * this time may have become earlier (new Interest at the head, RTO decreased).  The pending event
+ * is moved only when the new deadline is earlier than the scheduled one.  If the deadline moved
+ * later, the event fires early, the owner finds nothing expired and re-arms the timer.  Nothing
+ * is scheduled while the owner does not call Arm, i.e., while there are no outstanding Interests.
+ */
+class RetxTimer
+{
+public:
+  RetxTimer ();
+
+  /**
+   * @brief Cancels the pending event
+   */
+  ~RetxTimer ();
+
+  /**
+   * @brief Set function to be called when the timer expires
+   */
+  void
+  SetFunction (const Callback<void> &function);
+
+  /**
+   * @brief Make sure the function is called no later than the deadline (or now, if the deadline has passed)
+   */
+  void
+  Arm (const Time &deadline);
+
+  /**
+   * @brief Cancel the pending event, if any
+   */
+  void
+  Cancel ();
+
+  bool
+  IsRunning () const;
+
+private:
+  void
+  Expire ();
+
+private:
+  Callback<void> m_function;
+  EventId m_event;
+  Time    m_deadline; ///< @brief Time for which m_event is scheduled
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RETX_TIMER_H
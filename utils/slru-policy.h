@@ -0,0 +1,203 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SLRU_POLICY_H_
+#define SLRU_POLICY_H_
+
+#include "detail/functor-hook.h"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Segmented LRU replacement policy
+ *
+ * New entries are placed into the probationary LRU segment and are promoted into the
+ * protected LRU segment on the first hit.  Entries demoted from the protected segment
+ * (when it exceeds its share of max_size, 80% by default) go back to the probationary
+ * segment, and victims are always taken from the probationary segment first.  One-time
+ * requests therefore never displace entries that were requested at least twice
+ */
+struct slru_policy_traits
+{
+  struct policy_hook_type : public boost::intrusive::list_member_hook<>
+  {
+    policy_hook_type () : protected_ (false) { }
+    bool protected_; ///< @brief true if entry is in the protected segment
+  };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::function_hook< detail::MemberHook<Container, policy_hook_type> > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy 
+  {
+    typedef typename detail::HookFunctor<Hook>::type functor;
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    static bool& is_protected (typename Container::iterator item)
+    {
+      return functor::to_hook_ptr (*item)->protected_;
+    }
+
+    // probationary segment is the base container
+    class type : public policy_container
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+        , protected_ratio_ (0.8)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        lookup (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        if (max_size_ != 0 && size () >= max_size_)
+          {
+            if (!policy_container::empty ())
+              base_.erase (&(*policy_container::begin ()));
+            else
+              base_.erase (&(*protected_segment_.begin ()));
+          }
+
+        is_protected (item) = false;
+        policy_container::push_back (*item);
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        if (is_protected (item))
+          {
+            protected_segment_.splice (protected_segment_.end (),
+                                       protected_segment_,
+                                       protected_segment_.s_iterator_to (*item));
+            return;
+          }
+
+        policy_container::erase (policy_container::s_iterator_to (*item));
+        is_protected (item) = true;
+        protected_segment_.push_back (*item);
+
+        if (max_size_ != 0 && protected_segment_.size () > get_protected_size ())
+          {
+            // demote the least recently used protected entry
+            typename parent_trie::iterator demoted = &(*protected_segment_.begin ());
+            protected_segment_.pop_front ();
+            is_protected (demoted) = false;
+            policy_container::push_back (*demoted);
+          }
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        if (is_protected (item))
+          protected_segment_.erase (protected_segment_.s_iterator_to (*item));
+        else
+          policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        protected_segment_.clear ();
+      }
+
+      /**
+       * @brief Number of entries in both segments
+       */
+      inline size_t
+      size () const
+      {
+        return policy_container::size () + protected_segment_.size ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+      /**
+       * @brief Set share of max_size reserved for the protected segment (0..1)
+       */
+      inline void
+      set_protected_ratio (double ratio)
+      {
+        protected_ratio_ = ratio;
+      }
+
+      inline double
+      get_protected_ratio () const
+      {
+        return protected_ratio_;
+      }
+
+    private:
+      inline size_t
+      get_protected_size () const
+      {
+        return static_cast<size_t> (max_size_ * protected_ratio_);
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      double protected_ratio_;
+
+      policy_container protected_segment_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // SLRU_POLICY_H_
@@ -0,0 +1,128 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_SPSC_QUEUE_H
+#define NDNSIM_SPSC_QUEUE_H
+
+#include <vector>
+#include <stdint.h>
+#include <cstddef>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer and one consumer thread
+ *
+ * Each index is written by one side only. Memory barriers make sure the
+ * element is completely written before the producer publishes the new tail,
+ * and completely read before the consumer releases the slot
+ */
+template<class T>
+class spsc_queue
+{
+public:
+  /**
+   * @param capacity maximum number of queued elements (rounded up to a power of two)
+   */
+  explicit
+  spsc_queue (size_t capacity)
+    : head_ (0)
+    , tail_ (0)
+  {
+    size_t size = 1;
+    while (size < capacity + 1)
+      size <<= 1;
+
+    buffer_.resize (size);
+    mask_ = size - 1;
+  }
+
+  /**
+   * @brief Enqueue element (producer side only)
+   * @returns false if queue is full
+   */
+  inline bool
+  push (const T &value)
+  {
+    size_t tail = tail_;
+    size_t next = (tail + 1) & mask_;
+    if (next == head_)
+      return false;
+
+    __sync_synchronize (); // slot is no longer read by consumer
+    buffer_ [tail] = value;
+    __sync_synchronize ();
+    tail_ = next;
+    return true;
+  }
+
+  /**
+   * @brief Dequeue element (consumer side only)
+   * @returns false if queue is empty
+   */
+  inline bool
+  pop (T &value)
+  {
+    size_t head = head_;
+    if (head == tail_)
+      return false;
+
+    __sync_synchronize ();
+    value = buffer_ [head];
+    __sync_synchronize ();
+    head_ = (head + 1) & mask_;
+    return true;
+  }
+
+  /**
+   * @brief Approximate number of queued elements (exact if called from either side while other is idle)
+   */
+  inline size_t
+  size () const
+  {
+    return (tail_ - head_) & mask_;
+  }
+
+  inline size_t
+  capacity () const
+  {
+    return mask_;
+  }
+
+  inline bool
+  empty () const
+  {
+    return head_ == tail_;
+  }
+
+private:
+  std::vector<T> buffer_;
+  size_t mask_;
+
+  volatile size_t head_; ///< \brief next element to read, modified by consumer only
+  char padding_[64];     ///< \brief keep head and tail on different cache lines
+  volatile size_t tail_; ///< \brief next free slot, modified by producer only
+};
+
+} // namespace ndnSIM
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_SPSC_QUEUE_H
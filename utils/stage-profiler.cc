@@ -0,0 +1,139 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "stage-profiler.h"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/ndn-l3-protocol.h"
+
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.StageProfiler");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (StageProfiler);
+
+static const char *STAGE_NAMES [StageProfiler::STAGE_COUNT] = {
+  "Decode",
+  "ContentStore",
+  "Pit",
+  "Fib",
+  "Propagate",
+  "Send"
+};
+
+TypeId
+StageProfiler::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::StageProfiler")
+    .SetGroupName ("Ndn")
+    .SetParent<Object> ()
+    .AddConstructor<StageProfiler> ()
+    ;
+  return tid;
+}
+
+StageProfiler::StageProfiler ()
+{
+  Reset ();
+}
+
+const StageProfiler::Stats &
+StageProfiler::GetStats (Stage stage) const
+{
+  return m_stats [stage];
+}
+
+const char *
+StageProfiler::GetStageName (Stage stage)
+{
+  return STAGE_NAMES [stage];
+}
+
+void
+StageProfiler::Reset ()
+{
+  std::memset (m_stats, 0, sizeof (m_stats));
+}
+
+void
+StageProfiler::PrintHeader (std::ostream &os)
+{
+  os << "Node" << "\t"
+     << "Stage" << "\t"
+     << "Count" << "\t"
+     << "Total" << "\t"
+     << "Mean" << "\t"
+     << "Max" << "\n";
+}
+
+void
+StageProfiler::Print (std::ostream &os) const
+{
+  Ptr<Node> node = GetObject<Node> ();
+  for (uint32_t stage = 0; stage < STAGE_COUNT; stage++)
+    {
+      const Stats &stats = m_stats [stage];
+      os << (node != 0 ? node->GetId () : 0) << "\t"
+         << STAGE_NAMES [stage] << "\t"
+         << stats.m_count << "\t"
+         << stats.m_total << "\t"
+         << (stats.m_count > 0 ? static_cast<double> (stats.m_total) / stats.m_count : 0) << "\t"
+         << stats.m_max << "\n";
+    }
+}
+
+void
+StageProfiler::InstallAll ()
+{
+#ifndef NDN_STAGE_PROFILER
+  NS_LOG_WARN ("Stage profiling is not compiled in (configure with --enable-ndn-stage-profiler), "
+               "all stats will be zero");
+#endif
+
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      if ((*node)->GetObject<L3Protocol> () == 0 ||
+          (*node)->GetObject<StageProfiler> () != 0)
+        continue;
+
+      (*node)->AggregateObject (CreateObject<StageProfiler> ());
+    }
+}
+
+void
+StageProfiler::PrintAll (std::ostream &os)
+{
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      Ptr<StageProfiler> profiler = (*node)->GetObject<StageProfiler> ();
+      if (profiler != 0)
+        profiler->Print (os);
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
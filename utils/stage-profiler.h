@@ -0,0 +1,182 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_STAGE_PROFILER_H
+#define NDN_STAGE_PROFILER_H
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <iostream>
+#include <stdint.h>
+#include <time.h>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Per-node profiler of the forwarding pipeline stages
+ *
+ * Stages are measured with the CPU cycle counter (or monotonic clock in nanoseconds,
+ * if cycle counter is not available) and aggregated as count, total, and maximum.
+ * Measurements are inclusive: e.g., PROPAGATE includes SEND of the propagated Interests.
+ *
+ * Measurement points are compiled in only if NDN_STAGE_PROFILER is defined
+ * (./waf configure --enable-ndn-stage-profiler), otherwise NDN_PROFILE_STAGE
+ * expands to nothing. When compiled in, only nodes with StageProfiler aggregated
+ * (see InstallAll) are profiled.
+ */
+class StageProfiler : public Object
+{
+public:
+  enum Stage
+    {
+      DECODE = 0,    ///< @brief packet type detection and header deserialization in L3Protocol::Receive
+      CONTENT_STORE, ///< @brief content store lookup and insertion
+      PIT,           ///< @brief PIT lookup and creation of the PIT entry (includes FIB)
+      FIB,           ///< @brief FIB longest prefix match
+      PROPAGATE,     ///< @brief ForwardingStrategy::DoPropagateInterest
+      SEND,          ///< @brief Face::Send (encoding and passing packet to the lower layer)
+
+      STAGE_COUNT
+    };
+
+  struct Stats
+  {
+    uint64_t m_count;
+    uint64_t m_total;
+    uint64_t m_max;
+  };
+
+  /**
+   * @brief Measures time between construction and destruction, if profiler is not null
+   */
+  class Scope
+  {
+  public:
+    inline
+    Scope (const Ptr<StageProfiler> &profiler, Stage stage)
+      : m_profiler (PeekPointer (profiler))
+      , m_stage (stage)
+      , m_start (m_profiler != 0 ? GetCycles () : 0)
+    {
+    }
+
+    inline
+    ~Scope ()
+    {
+      if (m_profiler != 0)
+        m_profiler->Record (m_stage, GetCycles () - m_start);
+    }
+
+  private:
+    StageProfiler *m_profiler;
+    Stage m_stage;
+    uint64_t m_start;
+  };
+
+  static TypeId
+  GetTypeId ();
+
+  StageProfiler ();
+
+  /**
+   * @brief Read current value of the cycle counter
+   */
+  static inline uint64_t
+  GetCycles ()
+  {
+#if defined(__i386__) || defined(__x86_64__)
+    uint32_t low, high;
+    __asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high));
+    return (static_cast<uint64_t> (high) << 32) | low;
+#else
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t> (now.tv_sec) * 1000000000 + now.tv_nsec;
+#endif
+  }
+
+  inline void
+  Record (Stage stage, uint64_t cycles)
+  {
+    Stats &stats = m_stats [stage];
+    stats.m_count ++;
+    stats.m_total += cycles;
+    if (cycles > stats.m_max)
+      stats.m_max = cycles;
+  }
+
+  const Stats &
+  GetStats (Stage stage) const;
+
+  static const char *
+  GetStageName (Stage stage);
+
+  void
+  Reset ();
+
+  /**
+   * @brief Print tab-separated stats (Node, Stage, Count, Total, Mean, Max), one line per stage
+   */
+  void
+  Print (std::ostream &os) const;
+
+  static void
+  PrintHeader (std::ostream &os);
+
+  /**
+   * @brief Aggregate StageProfiler to all nodes that have NDN stack installed
+   */
+  static void
+  InstallAll ();
+
+  /**
+   * @brief Print stats of all nodes that have StageProfiler installed
+   */
+  static void
+  PrintAll (std::ostream &os);
+
+private:
+  Stats m_stats [STAGE_COUNT];
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#ifdef NDN_STAGE_PROFILER
+
+#define NDN_STAGE_PROFILER_CONCAT_(a, b) a ## b
+#define NDN_STAGE_PROFILER_CONCAT(a, b) NDN_STAGE_PROFILER_CONCAT_ (a, b)
+
+/**
+ * @brief Profile the rest of the enclosing block as the specified stage
+ * @param profiler Ptr<StageProfiler> (may be null)
+ * @param stage one of StageProfiler::Stage values (e.g., PIT)
+ */
+#define NDN_PROFILE_STAGE(profiler, stage)                              \
+  ::ns3::ndn::StageProfiler::Scope NDN_STAGE_PROFILER_CONCAT (ndnStageScope, __LINE__) \
+    (profiler, ::ns3::ndn::StageProfiler::stage)
+
+#else
+
+#define NDN_PROFILE_STAGE(profiler, stage)
+
+#endif // NDN_STAGE_PROFILER
+
+#endif // NDN_STAGE_PROFILER_H
@@ -22,14 +22,20 @@
 #include "ns3/ndn-face.h"
 #include "ns3/log.h"
 
+#include <vector>
+
 NS_LOG_COMPONENT_DEFINE ("ndn.StatsTree");
 
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
+// number of steps between removals of decayed subtrees
+static const uint32_t PRUNE_INTERVAL = 10;
+
 StatsTree::StatsTree ()
   : m_tree ("")
+  , m_epoch (0)
 {
 }
 
@@ -38,68 +44,147 @@ StatsTree::Step ()
 {
   NS_LOG_FUNCTION (this);
 
-  // walking the tree, aggregating and stepping on every node, starting the leaves
-  // for (trie_type::
+  // Each update is applied to all nodes on the path to the root, so parents
+  // always hold aggregated counters. Decaying is postponed until a node is
+  // touched (see Sync)
+  m_epoch ++;
 
-  WalkLeftRightRoot (&m_tree);
-  m_tree.payload ().Step ();
-  NS_LOG_DEBUG ("[" << m_tree.key () << "] " << m_tree.payload ());  
+  if (m_epoch % PRUNE_INTERVAL == 0)
+    Prune ();
 }
 
 void
-StatsTree::NewPitEntry (const NameComponents &key)
+StatsTree::Prune ()
 {
-  std::pair<tree_type::iterator, bool> item = m_tree.insert (key, LoadStatsNode ());
+  // parent aggregates include everything below, so once a node decayed to
+  // zero its whole subtree can be dropped. Pre-order walk syncs parents first
+  std::vector<tree_type *> decayed;
+  tree_type::recursive_iterator item (&m_tree), end;
+  for (; item != end; item ++)
+    {
+      Sync (&(*item));
+      if (!item->payload ().IsZero ())
+        continue;
 
-  item.first->payload ().NewPitEntry ();
+      // only the topmost decayed node of a subtree is removed
+      bool topmost = true;
+      for (tree_type *parent = item->parent (); parent != 0 && topmost; parent = parent->parent ())
+        topmost = !parent->payload ().IsZero ();
+
+      if (topmost)
+        decayed.push_back (&(*item));
+    }
+
+  for (std::vector<tree_type *>::iterator node = decayed.begin ();
+       node != decayed.end ();
+       node++)
+    {
+      NS_LOG_DEBUG ("[" << (*node)->key () << "] decayed, pruning");
+
+      (*node)->clear ();
+      if ((*node)->parent () != 0)
+        (*node)->prune ();
+    }
 }
 
 void
-StatsTree::Incoming (const NameComponents &key, Ptr<Face> face)
+StatsTree::SyncAll () const
+{
+  tree_type::recursive_iterator item (const_cast<tree_type *> (&m_tree)), end;
+  for (; item != end; item ++)
+    {
+      Sync (&(*item));
+    }
+}
+
+StatsTree::tree_type *
+StatsTree::Insert (const NameComponents &key)
 {
-  std::pair<tree_type::iterator, bool> item = m_tree.insert (key, LoadStatsNode ());
+  return m_tree.insert (key, LoadStatsNode ()).first;
+}
 
-  item.first->payload ().AddIncoming (face);
+void
+StatsTree::Sync (tree_type *node) const
+{
+  node->payload ().Sync (m_epoch);
 }
 
 void
-StatsTree::Outgoing (const NameComponents &key, Ptr<Face> face)
+StatsTree::NewPitEntry (const NameComponents &key)
+{
+  for (tree_type *node = Insert (key); node != 0; node = node->parent ())
+    {
+      Sync (node);
+      node->payload ().NewPitEntry ();
+    }
+}
+
+void
+StatsTree::Incoming (const NameComponents &key, Ptr<Face> face)
 {
-  std::pair<tree_type::iterator, bool> item = m_tree.insert (key, LoadStatsNode ());
+  for (tree_type *node = Insert (key); node != 0; node = node->parent ())
+    {
+      Sync (node);
+      node->payload ().AddIncoming (face);
+    }
+}
 
-  item.first->payload ().AddOutgoing (face);
+void
+StatsTree::Outgoing (const NameComponents &key, Ptr<Face> face)
+{
+  for (tree_type *node = Insert (key); node != 0; node = node->parent ())
+    {
+      Sync (node);
+      node->payload ().AddOutgoing (face);
+    }
 }
 
 void
 StatsTree::Satisfy (const NameComponents &key)
 {
-  std::pair<tree_type::iterator, bool> item = m_tree.insert (key, LoadStatsNode ());
+  tree_type *origin = Insert (key);
+  Sync (origin);
+  origin->payload ().Satisfy ();
 
-  item.first->payload ().Satisfy ();
+  for (tree_type *node = origin->parent (); node != 0; node = node->parent ())
+    {
+      Sync (node);
+      node->payload ().Satisfy (origin->payload ());
+    }
 }
 
 void
 StatsTree::Timeout (const NameComponents &key)
 {
-  std::pair<tree_type::iterator, bool> item = m_tree.insert (key, LoadStatsNode ());
+  tree_type *origin = Insert (key);
+  Sync (origin);
+  origin->payload ().Timeout ();
 
-  item.first->payload ().Timeout ();
+  for (tree_type *node = origin->parent (); node != 0; node = node->parent ())
+    {
+      Sync (node);
+      node->payload ().Timeout (origin->payload ());
+    }
 }
 
 void
 StatsTree::Rx (const NameComponents &key, Ptr<Face> face, uint32_t amount)
 {
-  std::pair<tree_type::iterator, bool> item = m_tree.insert (key, LoadStatsNode ());
-
-  item.first->payload ().Rx (face, amount);
+  for (tree_type *node = Insert (key); node != 0; node = node->parent ())
+    {
+      Sync (node);
+      node->payload ().Rx (face, amount);
+    }
 }
 
 void
 StatsTree::Tx (const NameComponents &key, Ptr<Face> face, uint32_t amount)
 {
-  std::pair<tree_type::iterator, bool> item = m_tree.insert (key, LoadStatsNode ());
-
-  item.first->payload ().Tx (face, amount);
+  for (tree_type *node = Insert (key); node != 0; node = node->parent ())
+    {
+      Sync (node);
+      node->payload ().Tx (face, amount);
+    }
 }
 
 // const LoadStatsNode &
@@ -111,29 +196,27 @@ StatsTree::operator [] (const NameComponents &key) const
   bool reachLast;
   boost::tie (foundItem, reachLast, lastItem) = const_cast<tree_type&> (m_tree).find (key);
 
-  return lastItem->payload ();
-}
-
-const LoadStatsNode&
-StatsTree::WalkLeftRightRoot (tree_type *node)
-{
-  tree_type::point_iterator item (*node), end;
-
-  while (item != end)
+  std::vector<tree_type *> path;
+  for (tree_type *node = lastItem; node != 0; node = node->parent ())
     {
-      node->payload () += WalkLeftRightRoot (&*item);
-      item->payload ().Step ();
-
-      NS_LOG_DEBUG ("[" << item->key () << "] " << item->payload ());
-      // item->prune (); // will do only if necessary
-
-      tree_type::point_iterator prune_iterator = item;
-      item++;
+      path.push_back (node);
+    }
 
-      prune_iterator->prune ();
+  // bring averages on the path up to date, from the root down. Stats of a decayed
+  // node are represented by its parent (the node itself is removed by Step)
+  for (std::vector<tree_type *>::reverse_iterator node = path.rbegin ();
+       node != path.rend ();
+       node++)
+    {
+      Sync (*node);
+      if ((*node)->payload ().IsZero ())
+        {
+          tree_type *parent = (*node)->parent ();
+          return parent != 0 ? parent->payload () : (*node)->payload ();
+        }
     }
-  
-  return node->payload ();
+
+  return lastItem->payload ();
 }
 
 void
@@ -150,6 +233,7 @@ std::ostream &
 operator << (std::ostream &os, const StatsTree &tree)
 {
   // os << "[" << tree.m_tree.key () << "]: " << tree.m_tree.payload ();
+  tree.SyncAll ();
   os << tree.m_tree;
   return os;
 }
@@ -38,8 +38,20 @@ public:
   
   StatsTree ();
 
+  /**
+   * @brief Advance the stats epoch
+   *
+   * Averages are decayed lazily, only for nodes that are updated or requested
+   * after the step.  Every few steps, subtrees that have fully decayed are removed
+   */
   void
   Step ();
+
+  /**
+   * @brief Bring averages of all nodes up to date (e.g., before the whole tree is walked or printed)
+   */
+  void
+  SyncAll () const;
   
   void
   NewPitEntry (const NameComponents &key);
@@ -64,6 +76,13 @@ public:
 
   // const LoadStatsNode &
   // Get (const NameComponents &key) const;
+
+  /**
+   * @brief Get up-to-date stats for the longest existing prefix of the key
+   *
+   * If a node on the path has fully decayed, stats of its parent are returned.  The tree
+   * structure is not changed, decayed nodes are removed by Step
+   */
   const LoadStatsNode &
   operator [] (const NameComponents &key) const;
 
@@ -71,12 +90,18 @@ public:
   RemoveFace (Ptr<Face> face);
   
 private:
-  const LoadStatsNode &
-  WalkLeftRightRoot (tree_type *node);
+  tree_type *
+  Insert (const NameComponents &key);
 
+  void
+  Sync (tree_type *node) const;
+
+  void
+  Prune ();
   
 private:
   tree_type m_tree;
+  uint32_t m_epoch;
 
   friend std::ostream &
   operator << (std::ostream &os, const StatsTree &tree);
@@ -0,0 +1,260 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TINYLFU_POLICY_H_
+#define TINYLFU_POLICY_H_
+
+#include "detail/node-hash.h"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Count-min sketch of recent access frequencies with periodic aging
+ *
+ * Four rows of saturating 4-bit counters (stored in bytes).  After the number of
+ * recorded accesses reaches 10 times the number of tracked entries, all counters
+ * are halved, so that the sketch reflects recent popularity
+ */
+class frequency_sketch
+{
+public:
+  frequency_sketch ()
+    : mask_ (0)
+    , additions_ (0)
+    , sample_size_ (0)
+  {
+  }
+
+  /**
+   * @brief Resize the sketch for the expected number of entries (resets all counters)
+   */
+  inline void
+  resize (size_t entries)
+  {
+    size_t width = 64;
+    while (width < 4 * entries)
+      width <<= 1;
+
+    table_.assign (ROWS * width, 0);
+    mask_ = width - 1;
+    additions_ = 0;
+    sample_size_ = 10 * std::max<size_t> (entries, 1);
+  }
+
+  inline void
+  increment (uint64_t hash)
+  {
+    if (table_.empty ())
+      return;
+
+    bool added = false;
+    for (size_t row = 0; row < ROWS; row++)
+      {
+        uint8_t &counter = table_ [row * (mask_ + 1) + index (hash, row)];
+        if (counter < MAX_COUNT)
+          {
+            counter++;
+            added = true;
+          }
+      }
+
+    if (added && ++additions_ >= sample_size_)
+      age ();
+  }
+
+  inline uint8_t
+  estimate (uint64_t hash) const
+  {
+    if (table_.empty ())
+      return 0;
+
+    uint8_t count = MAX_COUNT;
+    for (size_t row = 0; row < ROWS; row++)
+      count = std::min (count, table_ [row * (mask_ + 1) + index (hash, row)]);
+    return count;
+  }
+
+  inline void
+  clear ()
+  {
+    std::fill (table_.begin (), table_.end (), 0);
+    additions_ = 0;
+  }
+
+private:
+  inline size_t
+  index (uint64_t hash, size_t row) const
+  {
+    // splitmix64 finalizer with a different offset for every row
+    uint64_t x = hash + (row + 1) * 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return static_cast<size_t> (x) & mask_;
+  }
+
+  inline void
+  age ()
+  {
+    for (std::vector<uint8_t>::iterator counter = table_.begin (); counter != table_.end (); counter++)
+      *counter >>= 1;
+    additions_ /= 2;
+  }
+
+private:
+  static const size_t ROWS = 4;
+  static const uint8_t MAX_COUNT = 15;
+
+  std::vector<uint8_t> table_;
+  size_t mask_;
+  size_t additions_;
+  size_t sample_size_;
+};
+
+/**
+ * @brief Traits for LRU replacement policy with TinyLFU admission
+ *
+ * Every insert attempt and every hit is recorded in a frequency sketch.  When the policy
+ * is full, a new entry is admitted only if it was requested more often (according to the
+ * sketch) than the least recently used entry, which is then evicted.  Otherwise insert
+ * fails and the new entry is not cached, so one-time requests do not flush the cache
+ */
+struct tinylfu_policy_traits
+{
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {};
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy 
+  {
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+    
+    class type : public policy_container
+    {
+    public:
+      typedef Container parent_trie;
+    
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+      {
+        sketch_.resize (max_size_);
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        // do relocation
+        policy_container::splice (policy_container::end (),
+                                  *this,
+                                  policy_container::s_iterator_to (*item));
+      }
+  
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        uint64_t hash = detail::node_hash (*item);
+        sketch_.increment (hash);
+
+        if (max_size_ != 0 && policy_container::size () >= max_size_)
+          {
+            typename parent_trie::iterator victim = &(*policy_container::begin ());
+            if (sketch_.estimate (hash) <= sketch_.estimate (detail::node_hash (*victim)))
+              {
+                // just return false. Indicating that insert "failed"
+                return false;
+              }
+
+            base_.erase (victim);
+          }
+      
+        policy_container::push_back (*item);
+        return true;
+      }
+  
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        sketch_.increment (detail::node_hash (*item));
+
+        // do relocation
+        policy_container::splice (policy_container::end (),
+                                  *this,
+                                  policy_container::s_iterator_to (*item));
+      }
+  
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        sketch_.clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        sketch_.resize (max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      frequency_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // TINYLFU_POLICY_H_
@@ -117,6 +117,23 @@ public:
     return true;
   }
   
+  /**
+   * @brief Find a node that has the exact match with the key
+   */
+  inline iterator
+  find_exact (const FullKey &key)
+  {
+    iterator foundItem, lastItem;
+    bool reachLast;
+    boost::tie (foundItem, reachLast, lastItem) = trie_.find (key);
+
+    if (!reachLast || lastItem->payload () == PayloadTraits::empty_payload)
+      return end ();
+
+    policy_.lookup (s_iterator_to (lastItem));
+    return lastItem;
+  }
+
   /**
    * @brief Find a node that has the longest common prefix with key (FIB/PIT lookup)
    */
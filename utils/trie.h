@@ -22,6 +22,7 @@
 #define TRIE_H_
 
 #include "ns3/ptr.h"
+#include "memory-usage.h"
 
 #include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/list.hpp>
@@ -381,10 +382,46 @@ public:
     payload_ = payload;
   }
 
-  Key key () const
+  const Key &
+  key () const
   {
     return key_;
   }
+
+  /**
+   * @brief Get parent node of the trie (0 for the root node)
+   */
+  inline iterator
+  parent ()
+  {
+    return parent_;
+  }
+
+  inline const_iterator
+  parent () const
+  {
+    return parent_;
+  }
+
+  /**
+   * @brief Get number of bytes used by the trie structure (nodes, bucket arrays, and keys)
+   *
+   * Payloads are not accounted, as only the owner knows what they reference
+   */
+  inline size_t
+  memory_usage () const
+  {
+    size_t size = sizeof (trie) + bucketSize_ * sizeof (bucket_type) + DynamicSize (key_);
+
+    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+    for (typename trie::unordered_set::const_iterator subnode = children_.begin ();
+         subnode != children_.end ();
+         subnode++ )
+      {
+        size += subnode->memory_usage ();
+      }
+    return size;
+  }
   
   inline void
   PrintStat (std::ostream &os) const;  